@@ -0,0 +1,103 @@
+# Compiles the codegen probes in `SOURCE` and fails when one of them got
+# worse than what a hand written tagged struct compiles to:
+#
+#   * `probe_<name>` needs more than `hand_<name>` + `SLACK` instructions
+#   * a probe calls anything or has a cold part split off
+#   * the object has exception tables (`.gcc_except_table`)
+#   * a probe needs more instructions than `GOLDEN` allows, a file of
+#     `<probe> <max instructions>` lines for one compiler and target
+#
+#   cmake -DCXX=<compiler> -DFLAGS=<flags> -DSOURCE=<file> -DOBJECT=<file> -DOBJDUMP=<objdump>
+#         [-DGOLDEN=<file>] [-DSLACK=<n>] -P check-codegen.cmake
+
+foreach(var CXX SOURCE OBJECT OBJDUMP)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check-codegen: `${var}` is not set")
+    endif()
+endforeach()
+if(NOT DEFINED SLACK)
+    set(SLACK 0)
+endif()
+
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+execute_process(
+    COMMAND ${CXX} ${flags} -c ${SOURCE} -o ${OBJECT}
+    ERROR_VARIABLE compile_error
+    RESULT_VARIABLE compile_result
+)
+if(NOT compile_result EQUAL 0)
+    message(FATAL_ERROR "check-codegen: compiling ${SOURCE} failed:\n${compile_error}")
+endif()
+
+execute_process(
+    COMMAND ${OBJDUMP} -h ${OBJECT}
+    OUTPUT_VARIABLE sections
+    RESULT_VARIABLE objdump_result
+)
+if(NOT objdump_result EQUAL 0)
+    message(FATAL_ERROR "check-codegen: `${OBJDUMP} -h ${OBJECT}` failed")
+endif()
+
+set(failures "")
+if(sections MATCHES "\\.gcc_except_table")
+    string(APPEND failures "  the probes need exception tables (.gcc_except_table)\n")
+endif()
+
+include(${CMAKE_CURRENT_LIST_DIR}/disassembly.cmake)
+parse_disassembly(${OBJDUMP} ${OBJECT} "^(probe|hand)_" fn)
+if(fn_count EQUAL 0)
+    message(FATAL_ERROR "check-codegen: no probes in ${OBJECT}")
+endif()
+
+set(probes "")
+math(EXPR last "${fn_count} - 1")
+foreach(i RANGE ${last})
+    set(name "${fn_name_${i}}")
+    set(insns_of_${name} ${fn_insns_${i}})
+    if(name MATCHES "^probe_.*\\.cold$")
+        string(APPEND failures "  ${name}: cold part, a probe has a failure path\n")
+    elseif(name MATCHES "^probe_(.*)$")
+        list(APPEND probes "${CMAKE_MATCH_1}")
+        if(NOT fn_calls_${i} EQUAL 0)
+            string(APPEND failures "  ${name}: ${fn_calls_${i}} call(s)\n")
+        endif()
+    endif()
+endforeach()
+
+set(report "")
+foreach(probe IN LISTS probes)
+    set(insns ${insns_of_probe_${probe}})
+    if(NOT DEFINED insns_of_hand_${probe})
+        string(APPEND failures "  probe_${probe}: no hand_${probe} to compare with\n")
+        continue()
+    endif()
+    set(baseline ${insns_of_hand_${probe}})
+    string(APPEND report "  probe_${probe}: ${insns} instructions, hand written ${baseline}\n")
+    math(EXPR allowed "${baseline} + ${SLACK}")
+    if(insns GREATER allowed)
+        string(APPEND failures "  probe_${probe}: ${insns} instructions, hand written ${baseline}\n")
+    endif()
+endforeach()
+
+if(DEFINED GOLDEN)
+    file(STRINGS ${GOLDEN} golden_lines REGEX "^[^#]")
+    foreach(line IN LISTS golden_lines)
+        if(NOT line MATCHES "^([A-Za-z0-9_]+) +([0-9]+)$")
+            message(FATAL_ERROR "check-codegen: malformed line in ${GOLDEN}: `${line}`")
+        endif()
+        set(name "${CMAKE_MATCH_1}")
+        set(limit "${CMAKE_MATCH_2}")
+        if(NOT DEFINED insns_of_${name})
+            string(APPEND failures "  ${name}: listed in ${GOLDEN} but not found\n")
+        elseif(insns_of_${name} GREATER limit)
+            string(APPEND failures "  ${name}: ${insns_of_${name}} instructions, ${GOLDEN} allows ${limit}\n")
+        elseif(insns_of_${name} LESS limit)
+            message(STATUS "check-codegen: ${name} improved to ${insns_of_${name}} instructions, update ${GOLDEN}")
+        endif()
+    endforeach()
+endif()
+
+message(STATUS "check-codegen:\n${report}")
+if(failures)
+    message(FATAL_ERROR "check-codegen: codegen regressed:\n${failures}")
+endif()
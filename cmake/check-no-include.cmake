@@ -0,0 +1,27 @@
+# Fails if compiling `SOURCE` pulls in a header whose path matches `HEADER`.
+#
+#   cmake -DCXX=<compiler> -DFLAGS=<flags> -DSOURCE=<file> -DHEADER=<regex> -P check-no-include.cmake
+
+foreach(var CXX SOURCE HEADER)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check-no-include: `${var}` is not set")
+    endif()
+endforeach()
+
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+execute_process(
+    COMMAND ${CXX} ${flags} -fsyntax-only -H ${SOURCE}
+    OUTPUT_VARIABLE compiler_output
+    ERROR_VARIABLE include_tree
+    RESULT_VARIABLE compile_result
+)
+if(NOT compile_result EQUAL 0)
+    message(FATAL_ERROR "check-no-include: compiling ${SOURCE} failed:\n${include_tree}")
+endif()
+
+string(REPLACE "\n" ";" lines "${include_tree}")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^\\.+ (.*${HEADER})$")
+        message(FATAL_ERROR "check-no-include: ${SOURCE} includes ${CMAKE_MATCH_1}")
+    endif()
+endforeach()
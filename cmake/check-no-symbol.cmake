@@ -0,0 +1,32 @@
+# Fails when `BINARY` defines or references a symbol containing `SYMBOL`,
+# only when it defines one with `DEFINED_ONLY` set.
+#
+#   cmake -DNM=<nm> -DBINARY=<file> -DSYMBOL=<substring> [-DDEFINED_ONLY=ON] -P check-no-symbol.cmake
+
+foreach(var NM BINARY SYMBOL)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check-no-symbol: `${var}` is not set")
+    endif()
+endforeach()
+
+set(nm_flags "")
+if(DEFINED_ONLY)
+    set(nm_flags --defined-only)
+endif()
+
+execute_process(
+    COMMAND ${NM} ${nm_flags} ${BINARY}
+    OUTPUT_VARIABLE symbols
+    ERROR_VARIABLE nm_error
+    RESULT_VARIABLE nm_result
+)
+if(NOT nm_result EQUAL 0)
+    message(FATAL_ERROR "check-no-symbol: `${NM} ${BINARY}` failed: ${nm_error}")
+endif()
+
+string(REGEX MATCHALL "[^\n]*${SYMBOL}[^\n]*" matches "${symbols}")
+if(matches)
+    string(REPLACE ";" "\n  " matches "${matches}")
+    message(FATAL_ERROR "${BINARY} references `${SYMBOL}`:\n  ${matches}")
+endif()
+message(STATUS "${BINARY}: no `${SYMBOL}` symbols")
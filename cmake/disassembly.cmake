@@ -0,0 +1,68 @@
+# Helpers for scripts that look at optimized machine code, included by
+# measure-codesize.cmake and check-codegen.cmake.
+
+# Disassembles `object` with `objdump` and sets, in the caller's scope,
+# `<prefix>_count` and for every function whose name matches `filter`
+# `<prefix>_name_<i>`, `<prefix>_bytes_<i>`, `<prefix>_insns_<i>` and
+# `<prefix>_calls_<i>`. Alignment padding after the last instruction (nops,
+# int3) is not counted.
+function(parse_disassembly objdump object filter prefix)
+    execute_process(
+        COMMAND ${objdump} -d -C ${object}
+        OUTPUT_VARIABLE disassembly
+        ERROR_VARIABLE objdump_error
+        RESULT_VARIABLE objdump_result
+    )
+    if(NOT objdump_result EQUAL 0)
+        message(FATAL_ERROR "`${objdump} -d ${object}` failed: ${objdump_error}")
+    endif()
+
+    string(REPLACE ";" "," disassembly "${disassembly}")
+    string(REPLACE "\n" ";" lines "${disassembly}")
+
+    set(count 0)
+    set(current -1)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^[0-9a-f]+ <(.+)>:$")
+            set(name "${CMAKE_MATCH_1}")
+            if(name MATCHES "${filter}")
+                set(current ${count})
+                set(name_${current} "${name}")
+                set(bytes_${current} 0)
+                set(insns_${current} 0)
+                set(calls_${current} 0)
+                math(EXPR count "${count} + 1")
+            else()
+                set(current -1)
+            endif()
+        elseif(current GREATER -1 AND line MATCHES "^ +[0-9a-f]+:\t([0-9a-f ]+)(\t(.*))?$")
+            set(instruction "${CMAKE_MATCH_3}")
+            string(STRIP "${CMAKE_MATCH_1}" raw)
+            if(instruction MATCHES "^(data16 |cs )*(nop|xchg +%ax,%ax|int3)")
+                continue()
+            endif()
+
+            string(REPLACE " " ";" raw "${raw}")
+            list(LENGTH raw nbytes)
+            math(EXPR bytes_${current} "${bytes_${current}} + ${nbytes}")
+            # continuation lines of long encodings carry bytes only
+            if(instruction)
+                math(EXPR insns_${current} "${insns_${current}} + 1")
+                if(instruction MATCHES "^call")
+                    math(EXPR calls_${current} "${calls_${current}} + 1")
+                endif()
+            endif()
+        endif()
+    endforeach()
+
+    set(${prefix}_count ${count} PARENT_SCOPE)
+    if(count EQUAL 0)
+        return()
+    endif()
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE ${last})
+        foreach(field name bytes insns calls)
+            set(${prefix}_${field}_${i} "${${field}_${i}}" PARENT_SCOPE)
+        endforeach()
+    endforeach()
+endfunction()
@@ -0,0 +1,25 @@
+# Runs `BINARY` and passes only if it terminates abnormally with stderr
+# matching the regular expression `EXPECT`.
+#
+#   cmake -DBINARY=<file> -DEXPECT=<regex> -P expect-abort.cmake
+
+foreach(var BINARY EXPECT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "expect-abort: `${var}` is not set")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${BINARY}
+    OUTPUT_VARIABLE out
+    ERROR_VARIABLE err
+    RESULT_VARIABLE result
+)
+
+if(result EQUAL 0)
+    message(FATAL_ERROR "${BINARY} exited normally, expected it to abort")
+endif()
+if(NOT err MATCHES "${EXPECT}")
+    message(FATAL_ERROR "${BINARY} stderr does not match `${EXPECT}`:\n${err}")
+endif()
+message(STATUS "${BINARY} aborted with: ${err}")
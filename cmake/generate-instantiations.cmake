@@ -0,0 +1,20 @@
+# Writes a translation unit instantiating `use_every_member<I>` from
+# examples/compile_time/instantiations.hpp for `COUNT` distinct `I`, i.e.
+# `COUNT` distinct `Result` types. The file is only rewritten if it changed.
+#
+#   cmake -DCOUNT=<n> -DOUTPUT=<file> -P generate-instantiations.cmake
+
+foreach(var COUNT OUTPUT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "generate-instantiations: `${var}` is not set")
+    endif()
+endforeach()
+
+set(source "// generated by cmake/generate-instantiations.cmake, ${COUNT} Result types\n")
+string(APPEND source "#include \"examples/compile_time/instantiations.hpp\"\n\n")
+math(EXPR last "${COUNT} - 1")
+foreach(i RANGE ${last})
+    string(APPEND source "template int use_every_member<${i}>(int);\n")
+endforeach()
+
+file(CONFIGURE OUTPUT ${OUTPUT} CONTENT "${source}" @ONLY)
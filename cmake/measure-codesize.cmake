@@ -0,0 +1,41 @@
+# Prints byte size, instruction count and calls of every function in `OBJECT`
+# whose name matches `FILTER`, not counting alignment padding. Cold parts
+# split off by the compiler show up as their own `<name>.cold` entries.
+#
+#   cmake -DOBJDUMP=<objdump> -DOBJECT=<file> [-DFILTER=<regex>] -P measure-codesize.cmake
+
+foreach(var OBJDUMP OBJECT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "measure-codesize: `${var}` is not set")
+    endif()
+endforeach()
+if(NOT DEFINED FILTER)
+    set(FILTER ".*")
+endif()
+
+include(${CMAKE_CURRENT_LIST_DIR}/disassembly.cmake)
+parse_disassembly(${OBJDUMP} ${OBJECT} "${FILTER}" fn)
+
+if(fn_count EQUAL 0)
+    message(FATAL_ERROR "measure-codesize: no function in ${OBJECT} matches `${FILTER}`")
+endif()
+
+function(pad text width out)
+    string(LENGTH "${text}" len)
+    while(len LESS width)
+        string(APPEND text " ")
+        math(EXPR len "${len} + 1")
+    endwhile()
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+pad("function" 40 header)
+set(report "${header}  bytes  insns  calls\n")
+math(EXPR last "${fn_count} - 1")
+foreach(i RANGE ${last})
+    pad("${fn_name_${i}}" 40 row)
+    pad("${fn_bytes_${i}}" 5 bytes)
+    pad("${fn_insns_${i}}" 5 insns)
+    string(APPEND report "${row}  ${bytes}  ${insns}  ${fn_calls_${i}}\n")
+endforeach()
+message("${report}")
@@ -0,0 +1,52 @@
+# result_add_instantiations(<target> HEADER <name> TYPES <"T, E">... [INCLUDES <header>...])
+#
+# Adds a static library `<target>` holding the explicit instantiations of
+# `result_type::Result<T, E>` for every `"T, E"` in `TYPES`, and generates
+# the header `<name>` declaring them `extern`, see `RESULT_EXTERN_TEMPLATE` in
+# result/result.hpp. Translation units linking `<target>` include
+# `<name>` instead of result/result.hpp and no longer compile the
+# non-template members of those types themselves. `INCLUDES` are the headers
+# defining the `T` and `E` types, in `#include` syntax without the quotes.
+#
+#   include(cmake/result-instantiations.cmake)
+#   result_add_instantiations(common_results
+#       HEADER common_results.hpp
+#       TYPES "void, ErrCode" "int, ErrCode" "std::string, ErrCode"
+#       INCLUDES err_code.hpp <string>
+#   )
+#   target_link_libraries(app PRIVATE common_results)
+
+set(RESULT_INSTANTIATIONS_SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR}/..)
+
+function(result_add_instantiations target)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "HEADER" "TYPES;INCLUDES")
+    if(NOT arg_HEADER OR NOT arg_TYPES)
+        message(FATAL_ERROR "result_add_instantiations(${target}): HEADER and TYPES are required")
+    endif()
+
+    set(includes "")
+    foreach(header IN LISTS arg_INCLUDES)
+        if(header MATCHES "^<")
+            string(APPEND includes "#include ${header}\n")
+        else()
+            string(APPEND includes "#include \"${header}\"\n")
+        endif()
+    endforeach()
+
+    set(externs "")
+    set(instantiations "")
+    foreach(types IN LISTS arg_TYPES)
+        string(APPEND externs "RESULT_EXTERN_TEMPLATE(${types});\n")
+        string(APPEND instantiations "RESULT_INSTANTIATE_TEMPLATE(${types});\n")
+    endforeach()
+
+    set(directory ${CMAKE_CURRENT_BINARY_DIR}/${target})
+    set(banner "// generated by result_add_instantiations(${target}), see cmake/result-instantiations.cmake\n")
+    file(CONFIGURE OUTPUT ${directory}/${arg_HEADER}
+        CONTENT "${banner}#pragma once\n#include \"result/result.hpp\"\n${includes}\n${externs}" @ONLY)
+    file(CONFIGURE OUTPUT ${directory}/${target}.cpp
+        CONTENT "${banner}#include \"${arg_HEADER}\"\n\n${instantiations}" @ONLY)
+
+    add_library(${target} STATIC ${directory}/${target}.cpp)
+    target_include_directories(${target} PUBLIC ${directory} ${RESULT_INSTANTIATIONS_SOURCE_DIR})
+endfunction()
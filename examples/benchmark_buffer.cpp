@@ -0,0 +1,175 @@
+#include "benchmark_harness.hpp"
+#include "result/result-batch.hpp"
+#include "result/result-buffer.hpp"
+#include "result/result.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace result_type;
+
+// `ResultBuffer<T, E>` against a `std::vector<Result<T, E>>` holding the same
+// elements, at several error densities: the bytes per element of each, then
+// scans over every element and `batch_map` with every kernel the CPU has,
+// one pass over all elements per operation.
+
+constexpr std::size_t element_count       = std::size_t{1} << 20;
+constexpr std::uint32_t parts_per_million = 1000000;
+
+// 0%, 0.1%, 1%, 10%, 50%
+constexpr std::array<std::uint32_t, 5> error_rates_ppm{0, 1000, 10000, 100000, 500000};
+
+using Reading  = Result<double, std::uint32_t>;
+using Readings = ResultBuffer<double, std::uint32_t>;
+
+// the same scattered, reproducible errors for both containers
+inline bool fails(std::size_t index, std::uint32_t rate_ppm)
+{
+    const std::uint64_t mixed = (static_cast<std::uint64_t>(index) + 1) * 0x9e3779b97f4a7c15ull;
+    return (mixed >> 32) % parts_per_million < rate_ppm;
+}
+
+inline Reading decode(std::size_t index, std::uint32_t rate_ppm)
+{
+    if (fails(index, rate_ppm))
+    {
+        return make_err<double, std::uint32_t>(static_cast<std::uint32_t>(index));
+    }
+    return make_ok<double, std::uint32_t>(static_cast<double>(index % 1000) * 0.5);
+}
+
+// what the buffer allocates for its elements, the error store being one index
+// and one `E` per `Err`
+double bytes_per_element(const Readings &buffer)
+{
+    const std::size_t bytes = buffer.ok_bits_size() * sizeof(std::uint64_t) + buffer.size() * sizeof(double) +
+                              buffer.count_err() * (sizeof(std::size_t) + sizeof(std::uint32_t));
+    return static_cast<double>(bytes) / static_cast<double>(buffer.size());
+}
+
+void benchmark_density(bench::runner &run, std::uint32_t rate_ppm)
+{
+    std::vector<Reading> results;
+    Readings buffer;
+    results.reserve(element_count);
+    buffer.reserve(element_count);
+    for (std::size_t i = 0; i < element_count; ++i)
+    {
+        results.push_back(decode(i, rate_ppm));
+        buffer.push_back(decode(i, rate_ppm));
+    }
+
+    std::ostringstream title;
+    title << std::fixed << std::setprecision(1) << "scan of " << element_count << " Result<double, uint32_t>, "
+          << static_cast<double>(rate_ppm) / 10000.0 << "% Err, bytes per element: vector<Result> "
+          << sizeof(Reading) << ", ResultBuffer " << std::setprecision(2) << bytes_per_element(buffer);
+    run.section(title.str());
+
+    const auto count_vector = run.run("count Ok, vector<Result>",
+                                      [&](std::size_t)
+                                      {
+                                          std::size_t count = 0;
+                                          for (const Reading &reading : results)
+                                          {
+                                              count += reading.is_ok() ? 1 : 0;
+                                          }
+                                          return count;
+                                      });
+    const auto count_buffer = run.run("count Ok, ResultBuffer::count_ok(0, size)",
+                                      [&](std::size_t)
+                                      {
+                                          bench::do_not_optimize(buffer);
+                                          return buffer.count_ok(0, buffer.size());
+                                      });
+    run.compare("count, ResultBuffer vs vector", count_vector, count_buffer);
+
+    const auto sum_vector = run.run("sum Ok values, vector<Result>",
+                                    [&](std::size_t)
+                                    {
+                                        double sum = 0;
+                                        for (const Reading &reading : results)
+                                        {
+                                            if (reading.is_ok())
+                                            {
+                                                sum += reading.unwrap();
+                                            }
+                                        }
+                                        return sum;
+                                    });
+    const auto sum_buffer = run.run("sum Ok values, ResultBuffer::for_each_ok",
+                                    [&](std::size_t)
+                                    {
+                                        double sum = 0;
+                                        std::as_const(buffer).for_each_ok(
+                                            [&](std::size_t, double value)
+                                            {
+                                                sum += value;
+                                            });
+                                        return sum;
+                                    });
+    run.compare("sum, ResultBuffer vs vector", sum_vector, sum_buffer);
+
+    // the values stay bounded however often this runs
+    auto calibrate = [](double value)
+    {
+        return value * 0.5 + 250.0;
+    };
+    const auto map_vector = run.run("map Ok values, vector<Result> loop",
+                                    [&](std::size_t)
+                                    {
+                                        for (Reading &reading : results)
+                                        {
+                                            if (reading.is_ok())
+                                            {
+                                                double &value = reading.unwrap();
+                                                value         = calibrate(value);
+                                            }
+                                        }
+                                        bench::do_not_optimize(results);
+                                    });
+    run.run("map Ok values, batch_map(vector<Result>)",
+            [&](std::size_t)
+            {
+                batch_map(results.data(), results.size(), calibrate);
+                bench::do_not_optimize(results);
+            });
+
+    constexpr std::array<std::pair<batch_isa, const char *>, 4> kernels{{
+        {batch_isa::scalar, "map Ok values, batch_map(ResultBuffer) scalar"},
+        {batch_isa::sse2, "map Ok values, batch_map(ResultBuffer) SSE2"},
+        {batch_isa::avx2, "map Ok values, batch_map(ResultBuffer) AVX2"},
+        {batch_isa::avx512, "map Ok values, batch_map(ResultBuffer) AVX-512"},
+    }};
+    for (const auto &[isa, name] : kernels)
+    {
+        if (isa > detected_batch_isa())
+        {
+            continue;
+        }
+        const auto map_buffer = run.run(name,
+                                        [&, isa = isa](std::size_t)
+                                        {
+                                            batch_map(buffer, batch_pure(calibrate), isa);
+                                            bench::do_not_optimize(buffer);
+                                        });
+        if (isa == detected_batch_isa())
+        {
+            run.compare("map, batch_map(ResultBuffer) vs vector loop", map_vector, map_buffer);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bench::runner run{bench::parse_options(argc, argv)};
+    for (std::uint32_t rate : error_rates_ppm)
+    {
+        benchmark_density(run, rate);
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Probe functions for the `codesize` target. Each probe is an exported,
+// standalone function so its optimized machine code can be measured with
+// objdump, see cmake/measure-codesize.cmake.
+#include "result/result.hpp"
+#include <cstdlib>
+#include <string>
+
+using namespace result_type;
+
+using IntResult  = Result<int, std::string>;
+using VoidResult = Result<void, std::string>;
+
+extern "C"
+{
+    int probe_unwrap(const IntResult &result) { return result.unwrap(); }
+    int probe_unwrap_rvalue(IntResult &&result) { return std::move(result).unwrap(); }
+    const std::string &probe_unwrap_err(const IntResult &result) { return result.unwrap_err(); }
+    void probe_void_unwrap(const VoidResult &result) { result.unwrap(); }
+    int probe_unwrap_or(const IntResult &result) { return result.unwrap_or(0); }
+
+    // the shape `unwrap()` had before its failure path was outlined
+    int probe_unwrap_inline_panic(const IntResult &result)
+    {
+        if (result.is_err())
+        {
+            panic("called `Result::unwrap()` on an `Err` value ", result.unwrap_err());
+        }
+        return result.unwrap_or(0);
+    }
+
+    // lower bound, a hand written tagged struct
+    struct TaggedInt
+    {
+        int value;
+        bool ok;
+    };
+    int probe_handwritten(const TaggedInt &result)
+    {
+        if (!result.ok)
+        {
+            std::abort();
+        }
+        return result.value;
+    }
+}
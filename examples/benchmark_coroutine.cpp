@@ -0,0 +1,98 @@
+#include "benchmark_harness.hpp"
+#include "result/result-coroutine.hpp"
+#include <iostream>
+
+using namespace result_type;
+
+// Error propagation through a 10 level deep call stack, every level is its
+// own out-of-line function that adds one to the value coming from below.
+
+constexpr int depth = 10;
+
+enum class Fault
+{
+    Overflow,
+};
+
+std::ostream &operator<<(std::ostream &oss, Fault)
+{
+    oss << "Fault::Overflow";
+    return oss;
+}
+
+[[gnu::noinline]] Result<int, Fault> leaf(int value)
+{
+    if (value % 8 == 0)
+    {
+        return Err(Fault::Overflow);
+    }
+    return Ok(value);
+}
+
+template <int Level> [[gnu::noinline]] Result<int, Fault> by_hand(int value)
+{
+    if constexpr (Level == 0)
+    {
+        return leaf(value);
+    }
+    else
+    {
+        auto below = by_hand<Level - 1>(value);
+        if (below.is_err())
+        {
+            return Err(std::move(below).unwrap_err());
+        }
+        return Ok(std::move(below).unwrap() + 1);
+    }
+}
+
+template <int Level> [[gnu::noinline]] Result<int, Fault> with_try_ok(int value)
+{
+    if constexpr (Level == 0)
+    {
+        return leaf(value);
+    }
+    else
+    {
+        int below = TRY_OK(with_try_ok<Level - 1>(value));
+        return Ok(below + 1);
+    }
+}
+
+template <int Level> [[gnu::noinline]] Result<int, Fault> with_co_await(int value)
+{
+    if constexpr (Level == 0)
+    {
+        co_return co_await leaf(value);
+    }
+    else
+    {
+        int below = co_await with_co_await<Level - 1>(value);
+        co_return below + 1;
+    }
+}
+
+template <typename Chain> auto propagate(Chain chain)
+{
+    return [chain](std::size_t i)
+    {
+        return chain(static_cast<int>(i & 0xffff)).unwrap_or(-1);
+    };
+}
+
+int main(int argc, char **argv)
+{
+    std::cout << "=== Result propagation through " << depth << " levels (1 in 8 fails) ===\n\n";
+
+    bench::runner run{bench::parse_options(argc, argv)};
+    run.section("propagation");
+
+    auto hand      = run.run("if / return", propagate(by_hand<depth - 1>));
+    auto try_ok    = run.run("TRY_OK", propagate(with_try_ok<depth - 1>));
+    auto coroutine = run.run("co_await", propagate(with_co_await<depth - 1>));
+
+    run.compare("TRY_OK vs if / return", try_ok, hand);
+    run.compare("co_await vs if / return", coroutine, hand);
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include "benchmark_harness.hpp"
+#include "result/result.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#if __has_include(<expected>)
+#    include <expected>
+#endif
+
+using namespace result_type;
+
+// Error propagation across a matrix of failure rates, call stack depths and
+// error payload sizes, written as CSV to stdout:
+//
+//     approach,failure_percent,depth,payload_bytes,median_ns,p99_ns,mean_ns,stddev_ns
+//
+// Every approach runs the same out-of-line call stack: a leaf that fails
+// for the selected fraction of iterations and `depth - 1` callers above it,
+// each adding one to the value from below. The caller of the stack turns
+// the outcome back into an `int`.
+
+constexpr std::uint32_t parts_per_million = 1000000;
+
+// 0%, 0.001%, 0.1%, 1%, 10%, 60%, 100%
+constexpr std::array<std::uint32_t, 7> failure_rates_ppm{0, 10, 1000, 10000, 100000, 600000, parts_per_million};
+
+template <std::size_t N> struct Failure
+{
+    std::array<unsigned char, N> bytes;
+
+    Failure() = default;
+    explicit Failure(std::size_t seed) noexcept { bytes.fill(static_cast<unsigned char>(seed)); }
+};
+
+template <std::size_t N> struct result_type::result_debug<Failure<N>> : result_type::debug_opaque<Failure<N>>
+{
+};
+
+struct Input
+{
+    std::size_t index;
+    std::uint32_t failure_rate_ppm;
+};
+
+// the same scattered, reproducible failures for every approach
+inline bool fails(Input in)
+{
+    const std::uint64_t mixed = (static_cast<std::uint64_t>(in.index) + 1) * 0x9e3779b97f4a7c15ull;
+    return (mixed >> 32) % parts_per_million < in.failure_rate_ppm;
+}
+
+template <std::size_t N> int error_code_of(const Failure<N> &failure) { return -1 - failure.bytes[0]; }
+
+struct with_result
+{
+    static constexpr const char *name = "result_try_ok";
+
+    template <std::size_t N, int Level> [[gnu::noinline]] static Result<int, Failure<N>> call(Input in)
+    {
+        if constexpr (Level == 1)
+        {
+            if (fails(in))
+            {
+                return err_in_place(in.index);
+            }
+            return Ok(static_cast<int>(in.index));
+        }
+        else
+        {
+            int below = TRY_OK(call<N, Level - 1>(in));
+            return Ok(below + 1);
+        }
+    }
+
+    template <std::size_t N, int Depth> static int top(Input in)
+    {
+        auto result = call<N, Depth>(in);
+        return result.is_ok() ? std::move(result).unwrap() : error_code_of(result.unwrap_err());
+    }
+};
+
+struct with_exceptions
+{
+    static constexpr const char *name = "exceptions";
+
+    template <std::size_t N, int Level> [[gnu::noinline]] static int call(Input in)
+    {
+        if constexpr (Level == 1)
+        {
+            if (fails(in))
+            {
+                throw Failure<N>{in.index};
+            }
+            return static_cast<int>(in.index);
+        }
+        else
+        {
+            return call<N, Level - 1>(in) + 1;
+        }
+    }
+
+    template <std::size_t N, int Depth> static int top(Input in)
+    {
+        try
+        {
+            return call<N, Depth>(in);
+        }
+        catch (const Failure<N> &failure)
+        {
+            return error_code_of(failure);
+        }
+    }
+};
+
+// `0` or an error code, the value and the error details through out-params
+struct with_error_codes
+{
+    static constexpr const char *name = "error_codes";
+
+    template <std::size_t N, int Level>
+    [[gnu::noinline]] static int call(Input in, int &value, Failure<N> &failure)
+    {
+        if constexpr (Level == 1)
+        {
+            if (fails(in))
+            {
+                failure = Failure<N>{in.index};
+                return 1;
+            }
+            value = static_cast<int>(in.index);
+            return 0;
+        }
+        else
+        {
+            int below = 0;
+            if (int code = call<N, Level - 1>(in, below, failure))
+            {
+                return code;
+            }
+            value = below + 1;
+            return 0;
+        }
+    }
+
+    template <std::size_t N, int Depth> static int top(Input in)
+    {
+        int value = 0;
+        Failure<N> failure;
+        if (call<N, Depth>(in, value, failure) != 0)
+        {
+            return error_code_of(failure);
+        }
+        return value;
+    }
+};
+
+#if defined(__cpp_lib_expected)
+struct with_expected
+{
+    static constexpr const char *name = "std_expected";
+
+    template <std::size_t N, int Level> [[gnu::noinline]] static std::expected<int, Failure<N>> call(Input in)
+    {
+        if constexpr (Level == 1)
+        {
+            if (fails(in))
+            {
+                return std::unexpected<Failure<N>>(std::in_place, in.index);
+            }
+            return static_cast<int>(in.index);
+        }
+        else
+        {
+            auto below = call<N, Level - 1>(in);
+            if (!below)
+            {
+                return std::unexpected(std::move(below).error());
+            }
+            return *below + 1;
+        }
+    }
+
+    template <std::size_t N, int Depth> static int top(Input in)
+    {
+        auto expected = call<N, Depth>(in);
+        return expected ? *expected : error_code_of(expected.error());
+    }
+};
+#endif
+
+template <typename Approach, std::size_t N, int Depth> void sweep_failure_rates(bench::runner &run)
+{
+    for (std::uint32_t rate : failure_rates_ppm)
+    {
+        const std::string label = std::string{Approach::name} + "/depth=" + std::to_string(Depth) +
+                                  "/payload=" + std::to_string(N) + "/ppm=" + std::to_string(rate);
+
+        const bench::stats stats = run.run(label,
+                                           [rate](std::size_t i)
+                                           {
+                                               return Approach::template top<N, Depth>(Input{i, rate});
+                                           });
+        if (!stats)
+        {
+            continue;
+        }
+
+        std::cout << Approach::name << ',' << 100.0 * rate / parts_per_million << ',' << Depth << ','
+                  << N << ',' << stats.median << ',' << stats.p99 << ',' << stats.mean << ',' << stats.stddev
+                  << std::endl;
+    }
+}
+
+template <typename Approach, std::size_t N> void sweep_depths(bench::runner &run)
+{
+    sweep_failure_rates<Approach, N, 1>(run);
+    sweep_failure_rates<Approach, N, 4>(run);
+    sweep_failure_rates<Approach, N, 16>(run);
+    sweep_failure_rates<Approach, N, 64>(run);
+}
+
+template <typename Approach> void sweep_payloads(bench::runner &run)
+{
+    sweep_depths<Approach, 8>(run);
+    sweep_depths<Approach, 64>(run);
+    sweep_depths<Approach, 512>(run);
+}
+
+int main(int argc, char **argv)
+{
+    // 336 cases, fewer and shorter samples than the other benchmarks
+    bench::options defaults;
+    defaults.samples = 21;
+    defaults.warmup  = std::chrono::milliseconds{5};
+    defaults.table   = false;
+
+    bench::runner run{bench::parse_options(argc, argv, defaults)};
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "approach,failure_percent,depth,payload_bytes,median_ns,p99_ns,mean_ns,stddev_ns\n";
+
+    sweep_payloads<with_result>(run);
+    sweep_payloads<with_exceptions>(run);
+    sweep_payloads<with_error_codes>(run);
+#if defined(__cpp_lib_expected)
+    sweep_payloads<with_expected>(run);
+#else
+    std::cerr << "std::expected is not available, build as C++23 to include it\n";
+#endif
+
+    return 0;
+}
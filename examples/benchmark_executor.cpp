@@ -0,0 +1,131 @@
+#include "benchmark_harness.hpp"
+#include "result/result-executor.hpp"
+#include "result/result.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace result_type;
+
+// Fine grained fallible tasks on an `Executor` against one `std::async` per
+// task, then tasks splitting their work into subtasks against a plain loop.
+// One fan-out, every task spawned and joined, per operation.
+
+constexpr std::size_t task_count    = 16;
+constexpr std::size_t task_elements = 512;
+constexpr std::size_t split_count   = std::size_t{1} << 16;
+
+using Sum = Result<std::int64_t, std::uint32_t>;
+
+// fails on a value no input has
+Sum checked_sum(const std::int32_t *values, std::size_t count)
+{
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (values[i] < 0)
+        {
+            return make_err<std::int64_t, std::uint32_t>(static_cast<std::uint32_t>(i));
+        }
+        sum += values[i];
+    }
+    return make_ok<std::int64_t, std::uint32_t>(sum);
+}
+
+Sum split_sum(Executor &executor, const std::int32_t *values, std::size_t count)
+{
+    if (count <= task_elements)
+    {
+        return checked_sum(values, count);
+    }
+    const std::size_t half = count / 2;
+    auto left              = executor.spawn(
+        [&executor, values, half]
+        {
+            return split_sum(executor, values, half);
+        });
+    Sum right = split_sum(executor, values + half, count - half);
+    Sum sum   = left.join();
+    if (sum.is_err() || right.is_err())
+    {
+        return sum.is_err() ? sum : right;
+    }
+    return make_ok<std::int64_t, std::uint32_t>(sum.unwrap() + right.unwrap());
+}
+
+int main(int argc, char **argv)
+{
+    bench::options opts;
+    // the workers need every CPU
+    opts.cpu = -1;
+    bench::runner run{bench::parse_options(argc, argv, opts)};
+
+    std::vector<std::int32_t> values(split_count);
+    std::iota(values.begin(), values.end(), 0);
+    Executor executor;
+
+    run.section(std::to_string(task_count) + " tasks summing " + std::to_string(task_elements) +
+                " integers, spawned and joined, " + std::to_string(executor.threads()) + " workers");
+    const auto async = run.run("std::async + future::get",
+                               [&](std::size_t)
+                               {
+                                   std::vector<std::future<Sum>> futures;
+                                   futures.reserve(task_count);
+                                   for (std::size_t i = 0; i < task_count; ++i)
+                                   {
+                                       futures.push_back(std::async(std::launch::async, checked_sum,
+                                                                    values.data() + i * task_elements,
+                                                                    task_elements));
+                                   }
+                                   std::int64_t total = 0;
+                                   for (std::future<Sum> &future : futures)
+                                   {
+                                       Sum sum = future.get();
+                                       total += sum.is_ok() ? sum.unwrap() : 0;
+                                   }
+                                   return total;
+                               });
+    const auto spawned = run.run("Executor::spawn + join_all",
+                                 [&](std::size_t)
+                                 {
+                                     std::vector<Task<std::int64_t, std::uint32_t>> tasks;
+                                     tasks.reserve(task_count);
+                                     for (std::size_t i = 0; i < task_count; ++i)
+                                     {
+                                         const std::int32_t *chunk = values.data() + i * task_elements;
+                                         tasks.push_back(executor.spawn(
+                                             [chunk]
+                                             {
+                                                 return checked_sum(chunk, task_elements);
+                                             }));
+                                     }
+                                     auto sums = join_all(tasks);
+                                     return sums.is_ok() ? std::accumulate(sums.unwrap().begin(),
+                                                                           sums.unwrap().end(), std::int64_t{0})
+                                                         : 0;
+                                 });
+    run.compare("Executor vs std::async", async, spawned);
+
+    run.section("sum of " + std::to_string(split_count) + " integers split into tasks of " +
+                std::to_string(task_elements));
+    const auto loop  = run.run("one loop",
+                               [&](std::size_t)
+                               {
+                                   return checked_sum(values.data(), values.size()).unwrap_or(0);
+                               });
+    const auto split = run.run("Executor, tasks spawning subtasks",
+                               [&](std::size_t)
+                               {
+                                   auto root = executor.spawn(
+                                       [&]
+                                       {
+                                           return split_sum(executor, values.data(), values.size());
+                                       });
+                                   return root.join().unwrap_or(0);
+                               });
+    run.compare("split into tasks vs one loop", loop, split);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "benchmark_harness.hpp"
+#include "result/result-future.hpp"
+#include "result/result.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace result_type;
+
+// `ResultPromise`/`ResultFuture` against `std::promise`/`std::future` of the
+// same `Result`: creating a pair, setting and getting it on one thread, one
+// pair per operation, then the round trip between two threads that answer
+// each other through a fresh pair per message.
+
+using Message = Result<std::uint64_t, std::uint32_t>;
+
+constexpr std::size_t round_trips = 1000;
+
+// a thread answering every ping with a pong, one pair per message each way,
+// all created up front; the time of one round trip per sample
+template <typename Promise, typename Future, typename Set, typename Get>
+double ping_pong(Set set, Get get)
+{
+    std::vector<Promise> pings(round_trips);
+    std::vector<Promise> pongs(round_trips);
+    std::vector<Future> ping_futures;
+    std::vector<Future> pong_futures;
+    for (std::size_t i = 0; i < round_trips; ++i)
+    {
+        ping_futures.push_back(pings[i].get_future());
+        pong_futures.push_back(pongs[i].get_future());
+    }
+
+    std::thread echo{[&]
+                     {
+                         for (std::size_t i = 0; i < round_trips; ++i)
+                         {
+                             set(pongs[i], get(ping_futures[i]));
+                         }
+                     }};
+    const auto start  = std::chrono::steady_clock::now();
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < round_trips; ++i)
+    {
+        set(pings[i], make_ok<std::uint64_t, std::uint32_t>(i));
+        sum += get(pong_futures[i]).unwrap();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    echo.join();
+    bench::do_not_optimize(sum);
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(round_trips);
+}
+
+template <typename Promise, typename Future, typename Set, typename Get>
+bench::stats sample_ping_pong(std::size_t samples, Set set, Get get)
+{
+    std::vector<double> per_round_trip;
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+        per_round_trip.push_back(ping_pong<Promise, Future>(set, get));
+    }
+    return bench::summarize(std::move(per_round_trip), round_trips);
+}
+
+int main(int argc, char **argv)
+{
+    bench::options opts;
+    // the echo thread needs a CPU as well
+    opts.cpu = -1;
+    opts     = bench::parse_options(argc, argv, opts);
+    bench::runner run{opts};
+
+    run.section("one thread: create a pair, set, get");
+    const auto standard = run.run("std::promise<Result>",
+                                  [](std::size_t i)
+                                  {
+                                      std::promise<Message> promise;
+                                      std::future<Message> future = promise.get_future();
+                                      promise.set_value(make_ok<std::uint64_t, std::uint32_t>(i));
+                                      return future.get().unwrap();
+                                  });
+    const auto result = run.run("ResultPromise",
+                                [](std::size_t i)
+                                {
+                                    ResultPromise<std::uint64_t, std::uint32_t> promise;
+                                    ResultFuture<std::uint64_t, std::uint32_t> future = promise.get_future();
+                                    promise.set_result(make_ok<std::uint64_t, std::uint32_t>(i));
+                                    return future.get().unwrap();
+                                });
+    run.compare("ResultPromise vs std::promise", standard, result);
+
+    const std::size_t samples = std::max<std::size_t>(1, opts.samples / 4);
+    const bench::stats standard_trip =
+        sample_ping_pong<std::promise<Message>, std::future<Message>>(
+            samples,
+            [](std::promise<Message> &promise, Message message)
+            {
+                promise.set_value(std::move(message));
+            },
+            [](std::future<Message> &future)
+            {
+                return future.get();
+            });
+    const bench::stats result_trip =
+        sample_ping_pong<ResultPromise<std::uint64_t, std::uint32_t>, ResultFuture<std::uint64_t, std::uint32_t>>(
+            samples,
+            [](ResultPromise<std::uint64_t, std::uint32_t> &promise, Message message)
+            {
+                promise.set_result(std::move(message));
+            },
+            [](ResultFuture<std::uint64_t, std::uint32_t> &future)
+            {
+                return future.get();
+            });
+    std::cout << "\nping-pong between two threads, " << samples << " samples of " << round_trips
+              << " round trips, ns per round trip\n"
+              << "  std::promise<Result>  median " << standard_trip.median << ", p99 " << standard_trip.p99 << '\n'
+              << "  ResultPromise         median " << result_trip.median << ", p99 " << result_trip.p99 << '\n'
+              << "  ResultPromise vs std::promise: " << standard_trip.median / result_trip.median << "x\n";
+    return 0;
+}
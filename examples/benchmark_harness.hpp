@@ -0,0 +1,567 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#    include <sched.h>
+#    if __has_include(<linux/perf_event.h>)
+#        include <linux/perf_event.h>
+#        include <sys/ioctl.h>
+#        include <sys/syscall.h>
+#        include <unistd.h>
+#        define BENCH_HAS_PERF_EVENTS 1
+#    endif
+#endif
+
+// Minimal micro benchmark harness shared by the example benchmarks.
+//
+// ``` cpp
+// bench::runner run{bench::parse_options(argc, argv)};
+// run.section("construction");
+// run.run("make_ok<int, std::string>", [](std::size_t i)
+// {
+//     return make_ok<int, std::string>(static_cast<int>(i));
+// });
+// ```
+//
+// A case is a callable doing one operation for the iteration index it is
+// given, whatever it returns is kept alive with `do_not_optimize`. Every case
+// is warmed up first, which also picks a batch size so one timed sample runs
+// for at least `options::min_sample`, then sampled `options::samples` times.
+// The report is per operation: median, p99, mean and standard deviation
+// across samples, and with `--counters` hardware counters averaged over all
+// samples.
+namespace bench
+{
+    // Forces `value` to be materialized, as if read by unknown code.
+    //
+    // Only scalars may go through a register: loading an aggregate that was
+    // just written field by field as one register defeats store forwarding
+    // and costs more than most of the operations measured here.
+    template <typename T> inline void do_not_optimize(const T &value)
+    {
+#if defined(__GNUC__)
+        if constexpr (std::is_scalar_v<T>)
+        {
+            asm volatile("" : : "r,m"(value) : "memory");
+        }
+        else
+        {
+            asm volatile("" : : "m"(value) : "memory");
+        }
+#else
+        static volatile const void *escape;
+        escape = &value;
+#endif
+    }
+
+    // Same, and `value` may have changed afterwards, so nothing known about
+    // it before (e.g. whether a `Result` holds a value) is known after.
+    template <typename T> inline void do_not_optimize(T &value)
+    {
+#if defined(__GNUC__)
+        if constexpr (std::is_scalar_v<T>)
+        {
+            asm volatile("" : "+r,m"(value) : : "memory");
+        }
+        else
+        {
+            asm volatile("" : "+m"(value) : : "memory");
+        }
+#else
+        static volatile void *escape;
+        escape = &value;
+#endif
+    }
+
+    // Every pending write reaches memory here.
+    inline void clobber_memory()
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // Restricts the calling thread to `cpu`, returns false where unsupported.
+    inline bool pin_to_cpu(int cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    // User space hardware counters of the calling thread through Linux
+    // `perf_event_open`. Each counter is opened on its own, so whatever the
+    // kernel, CPU or container allows is kept and the rest reads as NaN.
+    class counters
+    {
+    public:
+        static constexpr std::size_t count = 5;
+        static constexpr std::array<const char *, count> names{"insns", "cycles", "br-miss", "L1i-miss", "L1d-miss"};
+
+        using values = std::array<double, count>;
+
+        static values none() noexcept
+        {
+            values result;
+            result.fill(std::numeric_limits<double>::quiet_NaN());
+            return result;
+        }
+
+        counters()
+        {
+            fds_.fill(-1);
+#if defined(BENCH_HAS_PERF_EVENTS)
+            constexpr std::uint64_t l1_miss_read = PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                                                   PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+
+            const std::array<std::pair<std::uint32_t, std::uint64_t>, count> events{{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1I | l1_miss_read},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | l1_miss_read},
+            }};
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                perf_event_attr attr{};
+                attr.size           = sizeof(attr);
+                attr.type           = events[i].first;
+                attr.config         = events[i].second;
+                attr.disabled       = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+                // scales the count when the PMU is shared and multiplexed
+                attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                fds_[i]             = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fds_[i] < 0 && error_.empty())
+                {
+                    error_ = std::strerror(errno);
+                }
+            }
+#else
+            error_ = "perf_event_open is Linux only";
+#endif
+        }
+
+        counters(const counters &)            = delete;
+        counters &operator=(const counters &) = delete;
+
+        ~counters()
+        {
+#if defined(BENCH_HAS_PERF_EVENTS)
+            for (int fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        bool available(std::size_t counter) const noexcept { return fds_[counter] >= 0; }
+
+        bool any_available() const noexcept
+        {
+            return std::any_of(fds_.begin(), fds_.end(),
+                               [](int fd)
+                               {
+                                   return fd >= 0;
+                               });
+        }
+
+        // why the first unavailable counter could not be opened
+        const std::string &error() const noexcept { return error_; }
+
+        void start() noexcept
+        {
+#if defined(BENCH_HAS_PERF_EVENTS)
+            for (int fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // counts since `start`, NaN for counters that are unavailable or were
+        // never scheduled
+        values stop() noexcept
+        {
+            values result = none();
+#if defined(BENCH_HAS_PERF_EVENTS)
+            for (int fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::uint64_t data[3] = {};
+                if (fds_[i] < 0 || read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) ||
+                    data[2] == 0)
+                {
+                    continue;
+                }
+                result[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            }
+#endif
+            return result;
+        }
+
+    private:
+        std::array<int, count> fds_;
+        std::string error_;
+    };
+
+    struct options
+    {
+        std::size_t samples                 = 101;
+        std::chrono::nanoseconds warmup     = std::chrono::milliseconds{20};
+        std::chrono::nanoseconds min_sample = std::chrono::microseconds{200};
+        // only cases whose section or name contains it run
+        std::string filter;
+        // pins to the CPU the process started on by default, -1 disables
+        int cpu       = -2;
+        // print a table of the cases to stdout, off for benchmarks with
+        // their own output format
+        bool table    = true;
+        // read hardware counters around every case, see `counters`
+        bool counters = false;
+    };
+
+    // `--samples=N`, `--warmup-ms=N`, `--min-sample-us=N`, `--filter=TEXT`,
+    // `--cpu=N`, `--no-pin` and `--counters` on top of `opts`, exits on
+    // anything else
+    inline options parse_options(int argc, char **argv, options opts = {})
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            auto value_of              = [&](std::string_view flag) -> const char *
+            {
+                if (arg.substr(0, flag.size()) == flag)
+                {
+                    return argv[i] + flag.size();
+                }
+                return nullptr;
+            };
+
+            if (auto value = value_of("--samples="))
+            {
+                opts.samples = std::max<std::size_t>(1, std::strtoull(value, nullptr, 10));
+            }
+            else if (auto value = value_of("--warmup-ms="))
+            {
+                opts.warmup = std::chrono::milliseconds{std::strtoll(value, nullptr, 10)};
+            }
+            else if (auto value = value_of("--min-sample-us="))
+            {
+                opts.min_sample = std::chrono::microseconds{std::strtoll(value, nullptr, 10)};
+            }
+            else if (auto value = value_of("--filter="))
+            {
+                opts.filter = value;
+            }
+            else if (auto value = value_of("--cpu="))
+            {
+                opts.cpu = std::atoi(value);
+            }
+            else if (arg == "--no-pin")
+            {
+                opts.cpu = -1;
+            }
+            else if (arg == "--counters")
+            {
+                opts.counters = true;
+            }
+            else
+            {
+                std::cerr << "usage: " << argv[0] << " [--samples=N] [--warmup-ms=N] [--min-sample-us=N]"
+                          << " [--filter=TEXT] [--cpu=N | --no-pin] [--counters]\n";
+                std::exit(2);
+            }
+        }
+        return opts;
+    }
+
+    // nanoseconds per operation across the samples of one case
+    struct stats
+    {
+        std::size_t samples = 0;
+        std::size_t batch   = 0;
+        double median       = 0;
+        double p99          = 0;
+        double mean         = 0;
+        double stddev       = 0;
+        double min          = 0;
+        // per operation over all samples, NaN when not measured
+        bench::counters::values counters = bench::counters::none();
+
+        // false when the case was filtered out
+        explicit operator bool() const noexcept { return samples != 0; }
+    };
+
+    inline stats summarize(std::vector<double> per_op, std::size_t batch)
+    {
+        stats result;
+        if (per_op.empty())
+        {
+            return result;
+        }
+        std::sort(per_op.begin(), per_op.end());
+
+        const std::size_t count = per_op.size();
+        result.samples          = count;
+        result.batch            = batch;
+        result.min              = per_op.front();
+        result.median = count % 2 == 1 ? per_op[count / 2] : (per_op[count / 2 - 1] + per_op[count / 2]) / 2;
+        // nearest rank
+        result.p99    = per_op[static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(count))) - 1];
+
+        double sum    = 0;
+        for (double sample : per_op)
+        {
+            sum += sample;
+        }
+        result.mean     = sum / static_cast<double>(count);
+
+        double variance = 0;
+        for (double sample : per_op)
+        {
+            variance += (sample - result.mean) * (sample - result.mean);
+        }
+        result.stddev = count > 1 ? std::sqrt(variance / static_cast<double>(count - 1)) : 0;
+        return result;
+    }
+
+    class runner
+    {
+    public:
+        explicit runner(options opts) : opts_{std::move(opts)}
+        {
+            if (opts_.cpu == -2)
+            {
+#if defined(__linux__)
+                opts_.cpu = sched_getcpu();
+#else
+                opts_.cpu = -1;
+#endif
+            }
+            if (opts_.cpu >= 0 && !pin_to_cpu(opts_.cpu))
+            {
+                std::cerr << "warning: could not pin to CPU " << opts_.cpu << ", results may be noisy\n";
+                opts_.cpu = -1;
+            }
+
+            std::ostream &out = opts_.table ? std::cout : std::cerr;
+            out << opts_.samples << " samples of at least "
+                << std::chrono::duration_cast<std::chrono::microseconds>(opts_.min_sample).count()
+                << " us per case after " << std::chrono::duration_cast<std::chrono::milliseconds>(opts_.warmup).count()
+                << " ms of warmup, ";
+            if (opts_.cpu >= 0)
+            {
+                out << "pinned to CPU " << opts_.cpu << "\n";
+            }
+            else
+            {
+                out << "not pinned\n";
+            }
+
+            if (opts_.counters)
+            {
+                counters_.emplace();
+                if (!counters_->any_available())
+                {
+                    std::cerr << "warning: no hardware counters (" << counters_->error() << "), timing only\n";
+                    counters_.reset();
+                }
+                else if (!counters_->error().empty())
+                {
+                    std::cerr << "warning: some hardware counters are unavailable (" << counters_->error() << ")\n";
+                }
+            }
+        }
+
+        // the header is printed with the first case that is not filtered out
+        void section(std::string_view title)
+        {
+            section_        = title;
+            header_pending_ = true;
+        }
+
+        template <typename Op> stats run(std::string_view name, Op &&op)
+        {
+            if (!selected(name))
+            {
+                return {};
+            }
+
+            const std::size_t batch = calibrate(op);
+
+            std::vector<double> per_op;
+            per_op.reserve(opts_.samples);
+            std::size_t index = 0;
+            if (counters_)
+            {
+                counters_->start();
+            }
+            for (std::size_t sample = 0; sample < opts_.samples; ++sample)
+            {
+                per_op.push_back(static_cast<double>(time_batch(op, index, batch).count()) /
+                                 static_cast<double>(batch));
+                index += batch;
+            }
+            const counters::values counted = counters_ ? counters_->stop() : counters::none();
+
+            stats result                   = summarize(std::move(per_op), batch);
+            for (std::size_t i = 0; i < counters::count; ++i)
+            {
+                result.counters[i] = counted[i] / static_cast<double>(index);
+            }
+            report(name, result);
+            return result;
+        }
+
+        // prints how many times faster `candidate` is than `baseline`, by median
+        void compare(std::string_view what, const stats &baseline, const stats &candidate) const
+        {
+            if (!opts_.table || !baseline || !candidate)
+            {
+                return;
+            }
+            std::cout << "  " << what << ": " << std::fixed << std::setprecision(2)
+                      << baseline.median / candidate.median << "x\n";
+        }
+
+    private:
+        static constexpr int name_width   = 44;
+        static constexpr int number_width = 10;
+
+        void print_header()
+        {
+            std::cout << '\n' << section_ << '\n';
+            std::cout << std::left << std::setw(name_width) << "  case" << std::right << std::setw(number_width)
+                      << "median" << std::setw(number_width) << "p99" << std::setw(number_width) << "stddev"
+                      << std::setw(number_width) << "ops";
+            for (std::size_t i = 0; counters_ && i < counters::count; ++i)
+            {
+                if (counters_->available(i))
+                {
+                    std::cout << std::setw(number_width) << counters::names[i];
+                }
+            }
+            std::cout << (counters_ ? "  (ns, counts per op)\n" : "  (ns/op)\n");
+        }
+
+        bool selected(std::string_view name) const
+        {
+            return opts_.filter.empty() || section_.find(opts_.filter) != std::string::npos ||
+                   name.find(opts_.filter) != std::string_view::npos;
+        }
+
+        template <typename Op>
+        static std::chrono::nanoseconds time_batch(Op &op, std::size_t first, std::size_t batch)
+        {
+            using clock      = std::chrono::steady_clock;
+
+            const auto start = clock::now();
+            clobber_memory();
+            for (std::size_t i = first; i < first + batch; ++i)
+            {
+                if constexpr (std::is_void_v<decltype(op(i))>)
+                {
+                    op(i);
+                }
+                else
+                {
+                    auto result = op(i);
+                    do_not_optimize(result);
+                }
+            }
+            clobber_memory();
+            return clock::now() - start;
+        }
+
+        // runs `op` for the warmup time, doubling the batch until one batch
+        // takes at least `min_sample`
+        template <typename Op> std::size_t calibrate(Op &op) const
+        {
+            using clock                     = std::chrono::steady_clock;
+            constexpr std::size_t max_batch = std::size_t{1} << 30;
+
+            const auto deadline             = clock::now() + opts_.warmup;
+            std::size_t batch               = 1;
+            std::size_t index               = 0;
+            do
+            {
+                const auto elapsed = time_batch(op, index, batch);
+                index += batch;
+                if (elapsed < opts_.min_sample && batch < max_batch)
+                {
+                    batch *= 2;
+                }
+            } while (clock::now() < deadline);
+            return batch;
+        }
+
+        void report(std::string_view name, const stats &result)
+        {
+            if (!opts_.table)
+            {
+                return;
+            }
+            if (std::exchange(header_pending_, false))
+            {
+                print_header();
+            }
+            std::cout << "  " << std::left << std::setw(name_width - 2) << name << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(number_width) << result.median
+                      << std::setw(number_width) << result.p99 << std::setw(number_width) << result.stddev
+                      << std::setw(number_width) << result.samples * result.batch;
+            for (std::size_t i = 0; counters_ && i < counters::count; ++i)
+            {
+                if (counters_->available(i))
+                {
+                    std::cout << std::setw(number_width) << result.counters[i];
+                }
+            }
+            std::cout << '\n';
+        }
+
+        options opts_;
+        std::string section_;
+        bool header_pending_ = false;
+        std::optional<counters> counters_;
+    };
+} // namespace bench
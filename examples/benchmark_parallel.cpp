@@ -0,0 +1,146 @@
+#include "benchmark_harness.hpp"
+#include "result/result-parallel.hpp"
+#include "result/result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace result_type;
+
+// `parallel::try_transform` over 2^14 records: its scaling with the number
+// of workers when every record is valid, one transform per operation, then
+// how long it takes to return once a record in the middle fails.
+
+constexpr std::size_t record_count = std::size_t{1} << 14;
+
+struct Row
+{
+    std::uint64_t id;
+    std::uint64_t payload;
+};
+
+struct Record
+{
+    std::uint64_t id;
+    std::uint64_t checksum;
+};
+
+std::ostream &operator<<(std::ostream &os, const Record &record)
+{
+    return os << "Record{" << record.id << ", " << record.checksum << '}';
+}
+
+// index of the invalid row, none by default
+std::size_t invalid_row = record_count;
+// when `validate` found it, nanoseconds of `steady_clock`
+std::atomic<std::int64_t> failed_at{0};
+
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// about as much work per row as parsing and checking a few fields
+Result<Record, std::uint32_t> validate(const Row &row)
+{
+    std::uint64_t hash = row.payload;
+    for (int round = 0; round < 16; ++round)
+    {
+        hash = (hash ^ (hash >> 29)) * 0xbf58476d1ce4e5b9ull;
+    }
+    if (row.id == invalid_row)
+    {
+        failed_at.store(now_ns(), std::memory_order_relaxed);
+        return make_err<Record, std::uint32_t>(static_cast<std::uint32_t>(row.id));
+    }
+    return make_ok<Record, std::uint32_t>(Record{row.id, hash});
+}
+
+void benchmark_scaling(bench::runner &run, const std::vector<Row> &rows, std::vector<Record> &records,
+                       unsigned max_threads)
+{
+    run.section("try_transform of " + std::to_string(record_count) + " valid records");
+    bench::stats single;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+    {
+        const auto stats = run.run(std::to_string(threads) + " threads",
+                                   [&](std::size_t)
+                                   {
+                                       auto result = parallel::try_transform(rows.begin(), rows.end(),
+                                                                             records.begin(), validate, {threads});
+                                       bench::do_not_optimize(records);
+                                       return result.is_ok();
+                                   });
+        if (threads == 1)
+        {
+            single = stats;
+        }
+        else
+        {
+            run.compare("speedup over 1 thread", single, stats);
+        }
+    }
+}
+
+// from the failing `validate` call to `try_transform` returning, median and
+// p99 over `runs` transforms with the invalid row in the middle
+void benchmark_cancellation(const std::vector<Row> &rows, std::vector<Record> &records, unsigned max_threads,
+                            std::size_t runs)
+{
+    std::cout << "\ncancellation latency, Err at row " << record_count / 2 << " of " << record_count << '\n';
+    invalid_row = record_count / 2;
+    for (parallel::error_order order : {parallel::error_order::lowest_index, parallel::error_order::first_observed})
+    {
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+        {
+            std::vector<double> latency;
+            std::vector<double> total;
+            for (std::size_t i = 0; i < runs; ++i)
+            {
+                const std::int64_t start = now_ns();
+                auto result              = parallel::try_transform(rows.begin(), rows.end(), records.begin(),
+                                                                   validate, {threads, 0, order});
+                const std::int64_t stop  = now_ns();
+                bench::do_not_optimize(result);
+                latency.push_back(static_cast<double>(stop - failed_at.load(std::memory_order_relaxed)));
+                total.push_back(static_cast<double>(stop - start));
+            }
+            const bench::stats to_return = bench::summarize(std::move(latency), 1);
+            const bench::stats whole     = bench::summarize(std::move(total), 1);
+            std::cout << "  " << (order == parallel::error_order::lowest_index ? "lowest_index  " : "first_observed")
+                      << ' ' << threads << " threads: " << to_return.median / 1000 << " us median, "
+                      << to_return.p99 / 1000 << " us p99 to return, whole call " << whole.median / 1000
+                      << " us\n";
+        }
+    }
+    invalid_row = record_count;
+}
+
+int main(int argc, char **argv)
+{
+    bench::options opts;
+    opts.samples = 21;
+    // the workers need every CPU
+    opts.cpu     = -1;
+    bench::runner run{bench::parse_options(argc, argv, opts)};
+
+    std::vector<Row> rows(record_count);
+    for (std::size_t i = 0; i < record_count; ++i)
+    {
+        rows[i] = Row{i, i * 0x9e3779b97f4a7c15ull};
+    }
+    std::vector<Record> records(record_count);
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    benchmark_scaling(run, rows, records, max_threads);
+    benchmark_cancellation(rows, records, max_threads, 21);
+    return 0;
+}
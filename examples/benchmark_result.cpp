@@ -1,151 +1,440 @@
+#include "benchmark_harness.hpp"
+#include "result/result-pipeline.hpp"
 #include "result/result.hpp"
-#include <chrono>
+#include <array>
 #include <iostream>
-#include <random>
-#include <vector>
+#include <stdexcept>
+#include <string>
 
 using namespace result_type;
-using namespace std::chrono;
+using namespace std::literals;
 
-// Simple benchmark for Result<T, E> operations
-void benchmark_basic_operations()
+// `value` as far as the optimizer can tell, e.g. whether a `Result` is `Ok`
+// has to be tested at run time
+template <typename T> T opaque(T value)
 {
-    constexpr int iterations = 1000000;
+    bench::do_not_optimize(value);
+    return value;
+}
+
+void benchmark_construction(bench::runner &run)
+{
+    run.section("construction");
+
+    run.run("make_ok<int, std::string>",
+            [](std::size_t i)
+            {
+                return make_ok<int, std::string>(static_cast<int>(i));
+            });
+    run.run("Ok(int) into Result<int, std::string>",
+            [](std::size_t i) -> Result<int, std::string>
+            {
+                return Ok(static_cast<int>(i));
+            });
+    run.run("make_err<int, std::string>, short string",
+            [](std::size_t)
+            {
+                return make_err<int, std::string>("too big"s);
+            });
+    run.run("Err(int) into Result<int, int>",
+            [](std::size_t i) -> Result<int, int>
+            {
+                return Err(static_cast<int>(i));
+            });
+}
 
-    std::cout << "Benchmarking Result<T, E> operations (" << iterations << " iterations)...\n";
+// payload that is as expensive to move as it is to copy
+struct LargeMessage
+{
+    std::array<char, 4096> bytes;
 
-    // Test construction and basic operations
-    auto start        = high_resolution_clock::now();
+    explicit LargeMessage(int seed) noexcept { bytes.fill(static_cast<char>(seed)); }
 
-    volatile int sink = 0; // Prevent optimization
-    for (int i = 0; i < iterations; ++i)
+    friend std::ostream &operator<<(std::ostream &oss, const LargeMessage &msg)
     {
-        auto result = make_ok<int, std::string>(i);
-        if (result.is_ok())
-        {
-            sink += result.unwrap();
-        }
+        oss << "LargeMessage{" << static_cast<int>(msg.bytes[0]) << ", ...}";
+        return oss;
     }
+};
+
+[[gnu::noinline]] Result<LargeMessage, std::string> produce_via_ok(int seed) { return Ok(LargeMessage{seed}); }
+[[gnu::noinline]] Result<LargeMessage, std::string> produce_via_make_ok(int seed)
+{
+    return make_ok<LargeMessage, std::string>(LargeMessage{seed});
+}
+[[gnu::noinline]] Result<LargeMessage, std::string> produce_in_place(int seed) { return ok_in_place(seed); }
 
-    auto end      = high_resolution_clock::now();
-    auto duration = duration_cast<microseconds>(end - start);
+void benchmark_large_payload(bench::runner &run)
+{
+    run.section("construction, 4 KiB payload");
+
+    auto consume = [](auto producer)
+    {
+        return [producer](std::size_t i)
+        {
+            return producer(static_cast<int>(i)).unwrap().bytes[i % 4096];
+        };
+    };
 
-    std::cout << "Basic operations: " << duration.count() << " μs\n";
-    std::cout << "Per operation: " << static_cast<double>(duration.count()) / iterations << " μs\n";
+    auto via_ok   = run.run("return Ok(msg)", consume(produce_via_ok));
+    run.run("return make_ok(msg)", consume(produce_via_make_ok));
+    auto in_place = run.run("return ok_in_place(args)", consume(produce_in_place));
+
+    run.compare("ok_in_place vs Ok(msg)", via_ok, in_place);
 }
 
-void benchmark_chaining()
+void benchmark_observers(bench::runner &run)
 {
-    constexpr int iterations = 100000;
+    run.section("observers, Result<int, int>");
+
+    run.run("is_ok + unwrap",
+            [](std::size_t i)
+            {
+                auto result = opaque(make_ok<int, int>(static_cast<int>(i)));
+                return result.is_ok() ? result.unwrap() : 0;
+            });
+    run.run("unwrap_or on Ok",
+            [](std::size_t i)
+            {
+                return opaque(make_ok<int, int>(static_cast<int>(i))).unwrap_or(0);
+            });
+    run.run("unwrap_or on Err",
+            [](std::size_t i)
+            {
+                return opaque(make_err<int, int>(static_cast<int>(i))).unwrap_or(0);
+            });
+    run.run("match",
+            [](std::size_t i)
+            {
+                return opaque(make_ok<int, int>(static_cast<int>(i)))
+                    .match(
+                        [](int value)
+                        {
+                            return value;
+                        },
+                        [](int err)
+                        {
+                            return -err;
+                        });
+            });
+}
 
-    std::cout << "\nBenchmarking Result chaining (" << iterations << " iterations)...\n";
+int plus_one(int x) { return x + 1; }
+Result<int, int> checked_double(int x)
+{
+    if (x < 0)
+    {
+        return Err(x);
+    }
+    return Ok(x * 2);
+}
+Result<int, int> recover(int err) { return Ok(-err); }
 
-    auto start        = high_resolution_clock::now();
+void benchmark_monadics(bench::runner &run)
+{
+    run.section("monadics, Result<int, int>");
 
-    volatile int sink = 0;
-    for (int i = 0; i < iterations; ++i)
+    auto ok  = [](std::size_t i)
     {
-        auto result = make_ok<int, std::string>(i % 100)
-                          .and_then(
-                              [](int x) -> Result<int, std::string>
-                              {
-                                  return make_ok<int, std::string>(x * 2);
-                              })
-                          .map(
-                              [](int x)
-                              {
-                                  return x + 1;
-                              })
-                          .and_then(
-                              [](int x) -> Result<int, std::string>
-                              {
-                                  if (x > 150)
-                                  {
-                                      return make_err<int, std::string>("too big");
-                                  }
-                                  return make_ok<int, std::string>(x);
-                              })
-                          .unwrap_or(0);
+        return opaque(make_ok<int, int>(static_cast<int>(i)));
+    };
+    auto err = [](std::size_t i)
+    {
+        return opaque(make_err<int, int>(static_cast<int>(i)));
+    };
+
+    run.run("map on Ok",
+            [&](std::size_t i)
+            {
+                return ok(i).map(plus_one);
+            });
+    run.run("map on Err (skipped)",
+            [&](std::size_t i)
+            {
+                return err(i).map(plus_one);
+            });
+    run.run("map_err on Err",
+            [&](std::size_t i)
+            {
+                return err(i).map_err(plus_one);
+            });
+    run.run("map_err on Ok (skipped)",
+            [&](std::size_t i)
+            {
+                return ok(i).map_err(plus_one);
+            });
+    run.run("and_then on Ok",
+            [&](std::size_t i)
+            {
+                return ok(i).and_then(checked_double);
+            });
+    run.run("and_then on Err (skipped)",
+            [&](std::size_t i)
+            {
+                return err(i).and_then(checked_double);
+            });
+    run.run("or_else on Err",
+            [&](std::size_t i)
+            {
+                return err(i).or_else(recover);
+            });
+    run.run("or_else on Ok (skipped)",
+            [&](std::size_t i)
+            {
+                return ok(i).or_else(recover);
+            });
+}
+
+// three out-of-line steps, the input decides whether the first one fails
+[[gnu::noinline]] Result<int, int> step(int x) { return checked_double(x); }
+
+[[gnu::noinline]] Result<int, int> propagate_try_ok(int x)
+{
+    int first  = TRY_OK(step(x));
+    int second = TRY_OK(step(first));
+    int third  = TRY_OK(step(second));
+    return Ok(third);
+}
 
-        sink += result;
+[[gnu::noinline]] Result<int, int> propagate_by_hand(int x)
+{
+    auto first = step(x);
+    if (first.is_err())
+    {
+        return Err(std::move(first).unwrap_err());
+    }
+    auto second = step(std::move(first).unwrap());
+    if (second.is_err())
+    {
+        return Err(std::move(second).unwrap_err());
+    }
+    auto third = step(std::move(second).unwrap());
+    if (third.is_err())
+    {
+        return Err(std::move(third).unwrap_err());
     }
+    return Ok(std::move(third).unwrap());
+}
 
-    auto end      = high_resolution_clock::now();
-    auto duration = duration_cast<microseconds>(end - start);
+void benchmark_propagation(bench::runner &run)
+{
+    run.section("propagation through 3 calls");
 
-    std::cout << "Chaining operations: " << duration.count() << " μs\n";
-    std::cout << "Per operation: " << static_cast<double>(duration.count()) / iterations << " μs\n";
+    run.run("TRY_OK, all Ok",
+            [](std::size_t i)
+            {
+                return propagate_try_ok(static_cast<int>(i & 0xffff));
+            });
+    run.run("TRY_OK, first fails",
+            [](std::size_t i)
+            {
+                return propagate_try_ok(-1 - static_cast<int>(i & 0xffff));
+            });
+    run.run("if / return, all Ok",
+            [](std::size_t i)
+            {
+                return propagate_by_hand(static_cast<int>(i & 0xffff));
+            });
+    run.run("if / return, first fails",
+            [](std::size_t i)
+            {
+                return propagate_by_hand(-1 - static_cast<int>(i & 0xffff));
+            });
 }
 
-void benchmark_vs_exceptions()
+void benchmark_chaining(bench::runner &run)
 {
-    constexpr int iterations = 10000;
+    run.section("chaining");
 
-    std::cout << "\nBenchmarking Result vs Exceptions (" << iterations << " iterations)...\n";
+    run.run("and_then / map / and_then / unwrap_or",
+            [](std::size_t i)
+            {
+                return make_ok<int, std::string>(static_cast<int>(i % 100))
+                    .and_then(
+                        [](int x) -> Result<int, std::string>
+                        {
+                            return make_ok<int, std::string>(x * 2);
+                        })
+                    .map(
+                        [](int x)
+                        {
+                            return x + 1;
+                        })
+                    .and_then(
+                        [](int x) -> Result<int, std::string>
+                        {
+                            if (x > 150)
+                            {
+                                return make_err<int, std::string>("too big");
+                            }
+                            return make_ok<int, std::string>(x);
+                        })
+                    .unwrap_or(0);
+            });
+}
 
-    // Result-based approach
-    auto start_result  = high_resolution_clock::now();
+// generated chains, even stages are a failing `and_then`, odd ones a `map`
+Result<int, std::string> checked_step(int x)
+{
+    if (x % 64 == 0)
+    {
+        return Err("multiple of 64"s);
+    }
+    return Ok(x + 1);
+}
 
-    volatile int sink1 = 0;
-    for (int i = 0; i < iterations; ++i)
+template <std::size_t I, std::size_t N> Result<int, std::string> eager_chain(Result<int, std::string> &&result)
+{
+    if constexpr (I == N)
     {
-        auto divide = [](int a, int b) -> Result<int, std::string>
-        {
-            if (b == 0)
-                return make_err<int, std::string>("div by zero");
-            return make_ok<int, std::string>(a / b);
-        };
+        return std::move(result);
+    }
+    else if constexpr (I % 2 == 0)
+    {
+        return eager_chain<I + 1, N>(std::move(result).and_then(checked_step));
+    }
+    else
+    {
+        return eager_chain<I + 1, N>(std::move(result).map(plus_one));
+    }
+}
 
-        auto result = divide(i, (i % 10 == 0) ? 0 : 1);
-        sink1 += result.unwrap_or(-1);
+template <std::size_t I> auto lazy_stage()
+{
+    if constexpr (I % 2 == 0)
+    {
+        return lazy::and_then(checked_step);
+    }
+    else
+    {
+        return lazy::map(plus_one);
     }
+}
+
+template <std::size_t... I>
+Result<int, std::string> lazy_chain(Result<int, std::string> &&result, std::index_sequence<I...>)
+{
+    return (std::move(result) | ... | lazy_stage<I>());
+}
 
-    auto end_result      = high_resolution_clock::now();
-    auto result_duration = duration_cast<microseconds>(end_result - start_result);
+template <std::size_t N> void benchmark_pipeline_length(bench::runner &run)
+{
+    const std::string length = std::to_string(N);
+
+    auto eager = run.run("eager, length " + length,
+                         [](std::size_t i)
+                         {
+                             auto source = make_ok<int, std::string>(static_cast<int>(i));
+                             return eager_chain<0, N>(std::move(source)).unwrap_or(0);
+                         });
+    auto fused = run.run("lazy, length " + length,
+                         [](std::size_t i)
+                         {
+                             auto source = make_ok<int, std::string>(static_cast<int>(i));
+                             return lazy_chain(std::move(source), std::make_index_sequence<N>{}).unwrap_or(0);
+                         });
+
+    run.compare("lazy vs eager, length " + length, eager, fused);
+}
+
+void benchmark_pipeline(bench::runner &run)
+{
+    run.section("eager chains vs lazy pipelines");
 
-    // Exception-based approach
-    auto start_exception = high_resolution_clock::now();
+    benchmark_pipeline_length<2>(run);
+    benchmark_pipeline_length<4>(run);
+    benchmark_pipeline_length<8>(run);
+    benchmark_pipeline_length<16>(run);
+    benchmark_pipeline_length<32>(run);
+}
 
-    volatile int sink2   = 0;
-    for (int i = 0; i < iterations; ++i)
+void benchmark_vs_exceptions(bench::runner &run)
+{
+    run.section("Result vs exceptions, 1 in 10 fails");
+
+    auto divide       = [](int a, int b) -> Result<int, std::string>
     {
-        auto divide_throw = [](int a, int b) -> int
-        {
-            if (b == 0)
-                throw std::runtime_error("div by zero");
-            return a / b;
-        };
+        if (b == 0)
+            return make_err<int, std::string>("div by zero");
+        return make_ok<int, std::string>(a / b);
+    };
+    auto divide_throw = [](int a, int b) -> int
+    {
+        if (b == 0)
+            throw std::runtime_error("div by zero");
+        return a / b;
+    };
 
-        try
-        {
-            sink2 += divide_throw(i, (i % 10 == 0) ? 0 : 1);
-        }
-        catch (...)
-        {
-            sink2 += -1;
-        }
-    }
+    auto result    = run.run("Result",
+                             [&](std::size_t i)
+                             {
+                                 return divide(static_cast<int>(i), (i % 10 == 0) ? 0 : 1).unwrap_or(-1);
+                             });
+    auto exception = run.run("exception",
+                             [&](std::size_t i)
+                             {
+                                 try
+                                 {
+                                     return divide_throw(static_cast<int>(i), (i % 10 == 0) ? 0 : 1);
+                                 }
+                                 catch (...)
+                                 {
+                                     return -1;
+                                 }
+                             });
 
-    auto end_exception      = high_resolution_clock::now();
-    auto exception_duration = duration_cast<microseconds>(end_exception - start_exception);
+    run.compare("Result vs exception", exception, result);
+}
+
+void benchmark_caught_panic(bench::runner &run)
+{
+    run.section("caught unwrap() panics, 4 KiB error");
 
-    std::cout << "Result approach: " << result_duration.count() << " μs\n";
-    std::cout << "Exception approach: " << exception_duration.count() << " μs\n";
-    std::cout << "Result is " << static_cast<double>(exception_duration.count()) / result_duration.count()
-              << "x faster\n";
+    const auto err = make_err<int, LargeMessage>(LargeMessage{1});
+
+    run.run("catch and discard",
+            [&](std::size_t)
+            {
+                try
+                {
+                    return err.unwrap();
+                }
+                catch (const panic_error &)
+                {
+                    return -1;
+                }
+            });
+    run.run("catch and read what()",
+            [&](std::size_t)
+            {
+                try
+                {
+                    return err.unwrap();
+                }
+                catch (const panic_error &e)
+                {
+                    return static_cast<int>(e.what()[0]);
+                }
+            });
 }
 
-int main()
+int main(int argc, char **argv)
 {
     std::cout << "=== Result<T, E> Performance Benchmarks ===\n\n";
 
-    benchmark_basic_operations();
-    benchmark_chaining();
-    benchmark_vs_exceptions();
+    bench::runner run{bench::parse_options(argc, argv)};
+
+    benchmark_construction(run);
+    benchmark_large_payload(run);
+    benchmark_observers(run);
+    benchmark_monadics(run);
+    benchmark_propagation(run);
+    benchmark_chaining(run);
+    benchmark_pipeline(run);
+    benchmark_vs_exceptions(run);
+    benchmark_caught_panic(run);
 
     std::cout << "\n=== Benchmark Complete ===\n";
-    std::cout << "Note: These are micro-benchmarks and actual performance may vary.\n";
-    std::cout << "The main benefit of Result<T, E> is expressiveness and safety, not just speed.\n";
 
     return 0;
 }
@@ -0,0 +1,114 @@
+// Probes for the codegen test, see cmake/check-codegen.cmake. Each
+// `probe_<name>` uses `Result` and is checked against `hand_<name>`, the
+// same logic over a hand written tagged struct: it must not need more
+// instructions, must not call anything and must not need exception tables.
+#include "result/result.hpp"
+
+using namespace result_type;
+
+using IntResult  = Result<int, int>;
+using VoidResult = Result<void, int>;
+
+// what `IntResult` and `VoidResult` boil down to, a zero discriminant
+// meaning `Ok` like `detail::ResultKind`
+struct TaggedInt
+{
+    int payload;
+    bool failed;
+};
+struct TaggedVoid
+{
+    int err;
+    bool failed;
+};
+
+namespace
+{
+    IntResult halve(int value)
+    {
+        if (value % 2 != 0)
+        {
+            return Err(value);
+        }
+        return Ok(value / 2);
+    }
+
+    IntResult add_one_or_propagate(IntResult &&result)
+    {
+        int value = TRY_OK(std::move(result));
+        return Ok(value + 1);
+    }
+
+    VoidResult propagate(VoidResult &&result)
+    {
+        TRY_OK(std::move(result));
+        return Ok();
+    }
+} // namespace
+
+extern "C"
+{
+    bool probe_is_ok(const IntResult &result) { return result.is_ok(); }
+    bool hand_is_ok(const TaggedInt &result) { return !result.failed; }
+
+    int probe_unwrap_or(const IntResult &result, int fallback) { return result.unwrap_or(fallback); }
+    int hand_unwrap_or(const TaggedInt &result, int fallback) { return !result.failed ? result.payload : fallback; }
+
+    int probe_map(const IntResult &result)
+    {
+        return result
+            .map(
+                [](int value)
+                {
+                    return value + 1;
+                })
+            .unwrap_or(0);
+    }
+    int hand_map(const TaggedInt &result) { return !result.failed ? result.payload + 1 : 0; }
+
+    int probe_and_then(const IntResult &result) { return result.and_then(halve).unwrap_or(-1); }
+    int hand_and_then(const TaggedInt &result)
+    {
+        if (result.failed || result.payload % 2 != 0)
+        {
+            return -1;
+        }
+        return result.payload / 2;
+    }
+
+    int probe_try_ok(IntResult &&result) { return add_one_or_propagate(std::move(result)).unwrap_err_or(0); }
+    int hand_try_ok(const TaggedInt &result) { return !result.failed ? 0 : result.payload; }
+
+    bool probe_void_is_ok(const VoidResult &result) { return result.is_ok(); }
+    bool hand_void_is_ok(const TaggedVoid &result) { return !result.failed; }
+
+    int probe_void_unwrap_err_or(const VoidResult &result) { return result.unwrap_err_or(0); }
+    int hand_void_unwrap_err_or(const TaggedVoid &result) { return !result.failed ? 0 : result.err; }
+
+    int probe_void_map(const VoidResult &result)
+    {
+        return result
+            .map(
+                []()
+                {
+                    return 1;
+                })
+            .unwrap_or(0);
+    }
+    int hand_void_map(const TaggedVoid &result) { return !result.failed ? 1 : 0; }
+
+    int probe_void_and_then(const VoidResult &result)
+    {
+        return result
+            .and_then(
+                []() -> IntResult
+                {
+                    return Ok(1);
+                })
+            .unwrap_or(0);
+    }
+    int hand_void_and_then(const TaggedVoid &result) { return !result.failed ? 1 : 0; }
+
+    int probe_void_try_ok(VoidResult &&result) { return propagate(std::move(result)).unwrap_err_or(0); }
+    int hand_void_try_ok(const TaggedVoid &result) { return !result.failed ? 0 : result.err; }
+}
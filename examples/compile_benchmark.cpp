@@ -0,0 +1,160 @@
+// Measures how long the compiler takes on a set of translation units, and
+// how much memory it needs, to track the cost of the headers.
+//
+//   compile_benchmark [--object] <repetitions> <compiler> [flags...] -- <label>=<source>...
+//
+// Every source is compiled `repetitions` times with `-fsyntax-only`, the
+// median wall time and the largest peak RSS are reported. With `--object`
+// the sources are compiled to an object file instead, whose size is
+// reported as well.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std::chrono;
+
+struct Sample
+{
+    double wall_ms;
+    long peak_rss_kib;
+};
+
+struct Case
+{
+    std::string label;
+    std::string source;
+};
+
+// runs `argv` to completion, returns false if it could not be run or failed
+bool run_once(std::vector<std::string> const &argv, Sample &sample)
+{
+    std::vector<char *> args;
+    for (auto const &arg : argv)
+    {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    auto start = steady_clock::now();
+    pid_t pid  = ::fork();
+    if (pid < 0)
+    {
+        return false;
+    }
+    if (pid == 0)
+    {
+        ::execvp(args[0], args.data());
+        ::_exit(127);
+    }
+
+    int status = 0;
+    rusage usage{};
+    if (::wait4(pid, &status, 0, &usage) != pid)
+    {
+        return false;
+    }
+    auto end            = steady_clock::now();
+
+    sample.wall_ms      = duration<double, std::milli>(end - start).count();
+    sample.peak_rss_kib = usage.ru_maxrss;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> compiler;
+    std::vector<Case> cases;
+
+    const bool object = argc > 1 && std::string{argv[1]} == "--object";
+    if (object)
+    {
+        --argc;
+        ++argv;
+    }
+
+    int i = 3;
+    for (; i < argc && std::string{argv[i]} != "--"; ++i)
+    {
+        compiler.emplace_back(argv[i]);
+    }
+    for (++i; i < argc; ++i)
+    {
+        std::string spec = argv[i];
+        auto eq          = spec.find('=');
+        if (eq == std::string::npos)
+        {
+            std::cerr << "expected <label>=<source>, got " << spec << "\n";
+            return EXIT_FAILURE;
+        }
+        cases.push_back({spec.substr(0, eq), spec.substr(eq + 1)});
+    }
+
+    int repetitions = argc > 1 ? std::atoi(argv[1]) : 0;
+    if (repetitions <= 0 || argc < 3 || cases.empty())
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [--object] <repetitions> <compiler> [flags...] -- <label>=<source>...\n";
+        return EXIT_FAILURE;
+    }
+    compiler.insert(compiler.begin(), argv[2]);
+
+    const auto object_file = std::filesystem::temp_directory_path() /
+                             ("compile_benchmark." + std::to_string(::getpid()) + ".o");
+
+    std::cout << "=== Compile cost (" << repetitions << " runs each, " << (object ? "-c" : "-fsyntax-only")
+              << ") ===\n\n";
+    std::cout << std::left << std::setw(24) << "case" << std::right << std::setw(14) << "median ms" << std::setw(16)
+              << "peak RSS KiB";
+    if (object)
+    {
+        std::cout << std::setw(16) << "object KiB";
+    }
+    std::cout << "\n";
+
+    for (auto const &each : cases)
+    {
+        std::vector<std::string> command = compiler;
+        if (object)
+        {
+            command.insert(command.end(), {"-c", each.source, "-o", object_file.string()});
+        }
+        else
+        {
+            command.insert(command.end(), {"-fsyntax-only", each.source});
+        }
+
+        std::vector<double> wall;
+        long peak_rss = 0;
+        for (int run = 0; run < repetitions; ++run)
+        {
+            Sample sample{};
+            if (!run_once(command, sample))
+            {
+                std::cerr << "compiling " << each.source << " failed\n";
+                return EXIT_FAILURE;
+            }
+            wall.push_back(sample.wall_ms);
+            peak_rss = std::max(peak_rss, sample.peak_rss_kib);
+        }
+
+        std::sort(wall.begin(), wall.end());
+        std::cout << std::left << std::setw(24) << each.label << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << wall[wall.size() / 2] << std::setw(16) << peak_rss;
+        if (object)
+        {
+            std::cout << std::setw(16) << std::filesystem::file_size(object_file) / 1024;
+            std::filesystem::remove(object_file);
+        }
+        std::cout << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+// Shared part of the generated instantiation benchmark, see
+// cmake/generate-instantiations.cmake. `use_every_member<I>` touches every
+// member of `Result<Value<I>, Error<I>>`, in every ref qualification, so
+// each `I` costs what one more distinct `Result` type costs a code base.
+#pragma once
+#include "result/result.hpp"
+#include <utility>
+
+template <int I> struct Value
+{
+    constexpr explicit Value(int init) noexcept : value{init} {}
+
+    int value;
+};
+template <int I> struct Error
+{
+    constexpr explicit Error(int init) noexcept : code{init} {}
+
+    int code;
+};
+
+template <int I> struct result_type::result_debug<Value<I>>
+{
+    static void format(result_type::debug_sink &sink, const Value<I> &value)
+    {
+        result_type::debug_write(sink, value.value);
+    }
+};
+template <int I> struct result_type::result_debug<Error<I>>
+{
+    static void format(result_type::debug_sink &sink, const Error<I> &error)
+    {
+        result_type::debug_write(sink, error.code);
+    }
+};
+
+template <int I> int use_every_member(int x)
+{
+    using R        = result_type::Result<Value<I>, Error<I>>;
+    using result_type::Err;
+    using result_type::Ok;
+
+    auto is_value  = [](const Value<I> &value)
+    {
+        return value.value > 0;
+    };
+    auto is_error  = [](const Error<I> &error)
+    {
+        return error.code > 0;
+    };
+    auto to_int    = [](auto &&value)
+    {
+        return value.value;
+    };
+    auto to_code   = [](auto &&error)
+    {
+        return error.code;
+    };
+    auto keep      = [](auto &&value) -> R
+    {
+        return Ok(Value<I>{value.value});
+    };
+    auto recover   = [](auto &&error) -> R
+    {
+        return Ok(Value<I>{error.code});
+    };
+    auto as_value  = [](auto &&value)
+    {
+        return Value<I>{value.value + 1};
+    };
+    auto as_error  = [](auto &&error)
+    {
+        return Error<I>{error.code + 1};
+    };
+
+    R ok           = Ok(Value<I>{x});
+    R err          = Err(Error<I>{x});
+    R in_place_ok  = result_type::ok_in_place(x);
+    R in_place_err = result_type::err_in_place(x);
+    const R cok    = ok;
+
+    err            = Err(Error<I>{x + 1});
+    ok             = Ok(Value<I>{x + 1});
+    in_place_ok.emplace_ok(x);
+    in_place_err.emplace_err(x);
+
+    int sum = ok.is_ok() + err.is_err();
+    sum += cok.is_ok_and(is_value) + R{ok}.is_ok_and(is_value);
+    sum += cok.is_err_and(is_error) + R{err}.is_err_and(is_error);
+    sum += ok.match(to_int, to_code) + cok.match(to_int, to_code) + R{ok}.match(to_int, to_code);
+
+    sum += ok.unwrap().value + cok.unwrap().value + R{ok}.unwrap().value + std::move(cok).unwrap().value;
+    sum += err.unwrap_err().code + std::as_const(err).unwrap_err().code + R{err}.unwrap_err().code +
+           std::move(std::as_const(err)).unwrap_err().code;
+    sum += cok.unwrap_or(Value<I>{0}).value + R{ok}.unwrap_or(Value<I>{0}).value;
+    sum += cok.unwrap_err_or(Error<I>{0}).code + R{err}.unwrap_err_or(Error<I>{0}).code;
+
+    sum += ok.and_then(keep).unwrap().value + cok.and_then(keep).unwrap().value + R{ok}.and_then(keep).unwrap().value +
+           std::move(cok).and_then(keep).unwrap().value;
+    sum += err.or_else(recover).unwrap().value + std::as_const(err).or_else(recover).unwrap().value +
+           R{err}.or_else(recover).unwrap().value + std::move(std::as_const(err)).or_else(recover).unwrap().value;
+    sum += ok.map(as_value).unwrap().value + cok.map(as_value).unwrap().value + R{ok}.map(as_value).unwrap().value +
+           std::move(cok).map(as_value).unwrap().value;
+    sum += err.map_err(as_error).unwrap_err().code + std::as_const(err).map_err(as_error).unwrap_err().code +
+           R{err}.map_err(as_error).unwrap_err().code +
+           std::move(std::as_const(err)).map_err(as_error).unwrap_err().code;
+
+    return sum + in_place_ok.unwrap().value + in_place_err.unwrap_err().code;
+}
@@ -0,0 +1,13 @@
+// the library headers as shipped
+#include "result/result.hpp"
+
+result_type::Result<int, int> parse(int value)
+{
+    if (value < 0)
+    {
+        return result_type::Err(value);
+    }
+    return result_type::Ok(value);
+}
+
+int use(int value) { return parse(value).unwrap(); }
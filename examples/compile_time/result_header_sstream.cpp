@@ -0,0 +1,16 @@
+// the library headers plus <sstream>, which they used to pull into every
+// translation unit, as the baseline before `result_debug`
+#include <sstream>
+
+#include "result/result.hpp"
+
+result_type::Result<int, int> parse(int value)
+{
+    if (value < 0)
+    {
+        return result_type::Err(value);
+    }
+    return result_type::Ok(value);
+}
+
+int use(int value) { return parse(value).unwrap(); }
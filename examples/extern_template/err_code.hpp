@@ -0,0 +1,19 @@
+// Error type of the extern template example, see
+// cmake/result-instantiations.cmake.
+#pragma once
+#include "result/result-debug.hpp"
+
+enum class ErrCode
+{
+    empty,
+    not_a_number,
+    out_of_range,
+};
+
+template <> struct result_type::result_debug<ErrCode>
+{
+    static void format(result_type::debug_sink &sink, ErrCode code)
+    {
+        result_type::debug_write(sink, static_cast<int>(code));
+    }
+};
@@ -0,0 +1,52 @@
+// Uses the `Result` types instantiated once in the `cpp-result_common_results`
+// library; the `extern_template_symbols` test checks this object does not
+// define their members again.
+#include "common_results.hpp"
+#include "parse.hpp"
+#include <cstdio>
+
+using namespace result_type;
+
+struct Endpoint
+{
+    std::string host;
+    int port;
+};
+
+template <> struct result_type::result_debug<Endpoint> : result_type::debug_opaque<Endpoint>
+{
+};
+
+Result<Endpoint, ErrCode> parse_endpoint(std::string_view host, std::string_view port)
+{
+    std::string name = TRY_OK(parse_name(host));
+    int number       = TRY_OK(parse_number(port));
+    TRY_OK(check_port(number));
+    return Ok(Endpoint{std::move(name), number});
+}
+
+int main()
+{
+    int failures = 0;
+    auto expect  = [&failures](bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", what);
+            ++failures;
+        }
+    };
+
+    auto endpoint = parse_endpoint("localhost", "8080");
+    expect(endpoint.is_ok(), "parse_endpoint(\"localhost\", \"8080\") is Ok");
+    expect(endpoint.is_ok() && endpoint.unwrap().port == 8080, "the port is 8080");
+
+    expect(parse_endpoint("", "8080").unwrap_err() == ErrCode::empty, "an empty host is rejected");
+    expect(parse_endpoint("localhost", "http").unwrap_err() == ErrCode::not_a_number, "a named port is rejected");
+    expect(parse_endpoint("localhost", "70000").unwrap_err() == ErrCode::out_of_range, "port 70000 is rejected");
+
+    expect(parse_number("12").map([](int value) { return value * 2; }).unwrap_or(0) == 24, "map on Result<int, E>");
+    expect(parse_name("x").is_ok_and([](const std::string &name) { return name == "x"; }), "Result<std::string, E>");
+
+    return failures == 0 ? 0 : 1;
+}
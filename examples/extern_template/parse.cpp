@@ -0,0 +1,38 @@
+#include "common_results.hpp"
+#include "parse.hpp"
+#include <charconv>
+
+using namespace result_type;
+
+Result<int, ErrCode> parse_number(std::string_view text)
+{
+    if (text.empty())
+    {
+        return Err(ErrCode::empty);
+    }
+    int value            = 0;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size())
+    {
+        return Err(ErrCode::not_a_number);
+    }
+    return Ok(value);
+}
+
+Result<std::string, ErrCode> parse_name(std::string_view text)
+{
+    if (text.empty())
+    {
+        return Err(ErrCode::empty);
+    }
+    return Ok(std::string{text});
+}
+
+Result<void, ErrCode> check_port(int port)
+{
+    if (port <= 0 || port > 65535)
+    {
+        return Err(ErrCode::out_of_range);
+    }
+    return Ok();
+}
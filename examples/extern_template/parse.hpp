@@ -0,0 +1,10 @@
+// Only names the `Result` types, result/result-fwd.hpp is enough.
+#pragma once
+#include "err_code.hpp"
+#include "result/result-fwd.hpp"
+#include <string>
+#include <string_view>
+
+result_type::Result<int, ErrCode> parse_number(std::string_view text);
+result_type::Result<std::string, ErrCode> parse_name(std::string_view text);
+result_type::Result<void, ErrCode> check_port(int port);
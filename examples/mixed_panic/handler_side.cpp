@@ -0,0 +1,19 @@
+#include "handler_side.hpp"
+#include "result/result.hpp"
+#include <cstdlib>
+#include <string_view>
+
+using namespace result_type;
+
+void panic_in_handler_side()
+{
+    set_panic_handler(
+        [](std::string_view message)
+        {
+            const bool expected = message.find("PANIC: ") == 0 &&
+                                  message.find("called `Result::unwrap()` on an `Err` value 7") !=
+                                      std::string_view::npos;
+            std::_Exit(expected ? EXIT_SUCCESS : EXIT_FAILURE);
+        });
+    detail::unwrap_failed<int, int>::unwrap(7);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+// defined in handler_side.cpp, built with `RESULT_PANIC_HANDLER`. Panics
+// through the same `unwrap_failed<int, int>` main.cpp throws from, the
+// installed handler ends the process with `EXIT_SUCCESS`.
+[[noreturn]] void panic_in_handler_side();
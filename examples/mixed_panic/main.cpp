@@ -0,0 +1,30 @@
+// Two translation units with different panic policies in one program, each
+// instantiating the same failure paths. Built with `RESULT_PANIC_THROW`, the
+// other one with `RESULT_PANIC_HANDLER`, see CMakeLists.txt.
+#include "handler_side.hpp"
+#include "result/result.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace result_type;
+
+int main()
+{
+    try
+    {
+        detail::unwrap_failed<int, int>::unwrap(7);
+    }
+    catch (const panic_error &)
+    {
+    }
+
+    try
+    {
+        panic_in_handler_side();
+    }
+    catch (...)
+    {
+        std::fputs("the `RESULT_PANIC_HANDLER` translation unit threw\n", stderr);
+    }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,29 @@
+// Exercises the non-throwing panic policies. Built once per policy with
+// exceptions disabled and `RESULT_PANIC_POLICY` set by the build.
+#include "result/result.hpp"
+#include <cstdlib>
+#include <string_view>
+
+using namespace result_type;
+using namespace std::literals;
+
+int main()
+{
+#if RESULT_PANIC_POLICY == RESULT_PANIC_HANDLER
+    set_panic_handler(
+        [](std::string_view message)
+        {
+            const bool expected = message.find("PANIC: ") == 0 &&
+                                  message.find("called `Result::unwrap()` on an `Err` value boom") !=
+                                      std::string_view::npos &&
+                                  message.back() == '\n';
+            std::_Exit(expected ? EXIT_SUCCESS : EXIT_FAILURE);
+        });
+#endif
+
+    auto result = make_err<int, std::string_view>("boom"sv);
+    (void)result.unwrap();
+
+    // unreachable, `unwrap` panics
+    return EXIT_FAILURE;
+}
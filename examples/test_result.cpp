@@ -1,11 +1,31 @@
-#include "result/result.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <charconv>
+#include <complex>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include "result/result.hpp"
+#include "result/result-batch.hpp"
+#include "result/result-buffer.hpp"
+#include "result/result-collect.hpp"
+#include "result/result-executor.hpp"
+#include "result/result-future.hpp"
+#include "result/result-parallel.hpp"
+#include "result/result-pipeline.hpp"
+#if defined(__cpp_impl_coroutine)
+#    include "result/result-coroutine.hpp"
+#endif
+
 using namespace result_type;
 using namespace std::literals;
 
@@ -96,6 +116,251 @@ struct ThrowOnMove
     }
 };
 
+// copying throws on request, counts destructor calls
+struct ThrowOnCopy
+{
+    static inline bool throw_next = false;
+    static inline int destroyed   = 0;
+
+    int value;
+    ThrowOnCopy(int v) noexcept : value(v) {}
+    ThrowOnCopy(const ThrowOnCopy &other) : value(other.value)
+    {
+        if (throw_next)
+        {
+            throw std::invalid_argument{"copy"};
+        }
+    }
+    ThrowOnCopy(ThrowOnCopy &&) noexcept            = default;
+    ThrowOnCopy &operator=(const ThrowOnCopy &)     = default;
+    ThrowOnCopy &operator=(ThrowOnCopy &&) noexcept = default;
+    ~ThrowOnCopy() { ++destroyed; }
+
+    friend std::ostream &operator<<(std::ostream &oss, const ThrowOnCopy &obj)
+    {
+        oss << "throw-on-copy: " << obj.value;
+        return oss;
+    }
+};
+
+enum class ErrCode : std::uint8_t
+{
+    NotFound = 1,
+    Invalid,
+};
+
+// throws on a negative value, for the strong guarantee of containers
+struct Picky
+{
+    int value = 0;
+
+    Picky() = default;
+    explicit Picky(int v) : value(v)
+    {
+        if (v < 0)
+        {
+            throw std::invalid_argument{"negative"};
+        }
+    }
+
+    friend std::ostream &operator<<(std::ostream &oss, const Picky &obj)
+    {
+        oss << "picky: " << obj.value;
+        return oss;
+    }
+};
+
+// no `operator<<`, printed as its underlying value
+enum Errno
+{
+    NoEntry  = 2,
+    NoMemory = 12,
+};
+
+// printed through an inserter template, which has to deduce `U`
+template <typename U> struct Box
+{
+    U content;
+};
+
+template <typename U> std::ostream &operator<<(std::ostream &oss, const Box<U> &box)
+{
+    oss << "box(" << box.content << ')';
+    return oss;
+}
+
+// converts to what `std::ostream` prints, but has no `operator<<` of its own
+struct Countdown
+{
+    operator int() const { return 3; }
+};
+
+std::ostream &operator<<(std::ostream &oss, ErrCode code)
+{
+    oss << "ErrCode(" << static_cast<int>(code) << ')';
+    return oss;
+}
+
+// counts how often a payload is moved or copied on its way into a `Result`
+struct MoveCounter
+{
+    static inline int moves  = 0;
+    static inline int copies = 0;
+
+    int value;
+    MoveCounter(int v) noexcept : value(v) {}
+    MoveCounter(const MoveCounter &other) : value(other.value) { ++copies; }
+    MoveCounter(MoveCounter &&other) noexcept : value(other.value) { ++moves; }
+    MoveCounter &operator=(const MoveCounter &) = default;
+    MoveCounter &operator=(MoveCounter &&)      = default;
+
+    static void reset() { moves = copies = 0; }
+
+    friend std::ostream &operator<<(std::ostream &oss, const MoveCounter &obj)
+    {
+        oss << "counter: " << obj.value;
+        return oss;
+    }
+};
+
+// counts how often a payload is streamed, i.e. how often a panic message was formatted
+struct FormatCounter
+{
+    static inline int formats = 0;
+
+    int value;
+
+    friend std::ostream &operator<<(std::ostream &oss, const FormatCounter &obj)
+    {
+        ++formats;
+        oss << "format-counter: " << obj.value;
+        return oss;
+    }
+};
+
+struct Widget
+{
+    int id;
+};
+
+struct alignas(8) Node
+{
+    Node *next;
+};
+
+// stateless error type, lets `Result` drop its tag next to a niche
+struct Missing
+{
+    friend std::ostream &operator<<(std::ostream &oss, Missing)
+    {
+        oss << "missing";
+        return oss;
+    }
+};
+
+enum class Status : std::uint8_t
+{
+    Unset = 0,
+    Busy,
+    Closed,
+};
+
+std::ostream &operator<<(std::ostream &oss, Status status)
+{
+    oss << "Status(" << static_cast<int>(status) << ')';
+    return oss;
+}
+
+// printable through an ADL `to_chars`, no `operator<<`
+struct Millis
+{
+    int count;
+};
+
+std::to_chars_result to_chars(char *first, char *last, const Millis &ms)
+{
+    auto result = std::to_chars(first, last, ms.count);
+    if (result.ec == std::errc{} && last - result.ptr >= 2)
+    {
+        *result.ptr++ = 'm';
+        *result.ptr++ = 's';
+    }
+    return result;
+}
+
+// printable only through an explicit `result_debug` specialization
+struct Handle
+{
+    const char *name;
+};
+
+// opts in to the type name and address fallback
+struct Socket
+{
+    int fd;
+};
+
+// not printable at all
+struct Silent
+{
+};
+
+// a niche payload counting its assignments, `id == -1` is the niche
+struct Pinned
+{
+    static inline int assignments = 0;
+
+    constexpr explicit Pinned(int id) : id{id} {}
+    Pinned(const Pinned &) = default;
+    Pinned &operator=(const Pinned &other)
+    {
+        ++assignments;
+        id = other.id;
+        return *this;
+    }
+
+    int id;
+};
+
+std::ostream &operator<<(std::ostream &oss, const Pinned &pinned)
+{
+    return oss << "Pinned(" << pinned.id << ')';
+}
+
+namespace result_type
+{
+    template <> struct result_debug<Handle>
+    {
+        static void format(debug_sink &sink, const Handle &handle)
+        {
+            sink.write("handle:");
+            sink.write(handle.name);
+        }
+    };
+    template <> struct result_debug<Socket> : debug_opaque<Socket>
+    {
+    };
+
+    template <> struct niche_traits<Widget *> : null_pointer_niche<Widget *>
+    {
+    };
+    template <> struct niche_traits<Node *> : misaligned_pointer_niche<Node *>
+    {
+    };
+    template <> struct niche_traits<std::unique_ptr<int>> : null_pointer_niche<std::unique_ptr<int>>
+    {
+    };
+    template <> struct niche_traits<Status> : enum_value_niche<Status, Status::Unset>
+    {
+    };
+    template <> struct niche_traits<Pinned>
+    {
+        static constexpr bool available = true;
+        static constexpr Pinned niche() noexcept { return Pinned{-1}; }
+        static constexpr bool is_niche(const Pinned &pinned) noexcept { return pinned.id == -1; }
+    };
+} // namespace result_type
+
 // Basic construction tests
 TEST(basic_construction)
 {
@@ -828,6 +1093,22 @@ TEST(move_semantics)
 
     auto nc_value = std::move(nc_result).unwrap();
     ASSERT_EQ(nc_value.value, 123);
+
+    // a copy that throws destroys nothing it did not construct
+    const auto source        = make_ok<ThrowOnCopy, std::string>(ThrowOnCopy{5});
+    ThrowOnCopy::throw_next = true;
+    ThrowOnCopy::destroyed  = 0;
+    try
+    {
+        auto copy = source;
+        ASSERT(false); // Should have thrown
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ThrowOnCopy::throw_next = false;
+    ASSERT_EQ(ThrowOnCopy::destroyed, 0);
+    ASSERT_EQ(source.unwrap().value, 5);
 }
 
 TEST(chaining_operations)
@@ -958,6 +1239,1134 @@ TEST(constexpr_operations)
     ASSERT(err_result);
 }
 
+TEST(trivial_storage)
+{
+    // Result is exactly as trivial as its payloads
+    static_assert(std::is_trivially_copyable_v<Result<int, int>>);
+    static_assert(std::is_trivially_destructible_v<Result<int, int>>);
+    static_assert(std::is_trivially_copyable_v<Result<int, std::string_view>>);
+    static_assert(std::is_trivially_copyable_v<Result<void, ErrCode>>);
+    static_assert(std::is_trivially_destructible_v<Result<void, ErrCode>>);
+    static_assert(sizeof(Result<int, int>) == 2 * sizeof(int));
+    static_assert(sizeof(Result<void, ErrCode>) == 2 * sizeof(ErrCode));
+
+    static_assert(!std::is_trivially_copyable_v<Result<std::string, int>>);
+    static_assert(!std::is_trivially_destructible_v<Result<int, std::string>>);
+    static_assert(!std::is_copy_constructible_v<Result<std::unique_ptr<int>, int>>);
+    static_assert(!std::is_copy_assignable_v<Result<std::unique_ptr<int>, int>>);
+    static_assert(std::is_nothrow_move_constructible_v<Result<std::unique_ptr<int>, std::string>>);
+
+    // non-trivial payloads still copy and assign across alternatives
+    auto ok  = make_ok<std::string, std::string>("value"s);
+    auto err = make_err<std::string, std::string>("error"s);
+
+    auto copy = ok;
+    ASSERT_EQ(copy.unwrap(), "value"s);
+    copy = err;
+    ASSERT(copy.is_err());
+    ASSERT_EQ(copy.unwrap_err(), "error"s);
+    copy = std::move(ok);
+    ASSERT(copy.is_ok());
+    ASSERT_EQ(copy.unwrap(), "value"s);
+    copy = Err("assigned"s);
+    ASSERT_EQ(copy.unwrap_err(), "assigned"s);
+}
+
+TEST(in_place_construction)
+{
+    MoveCounter::reset();
+    Result<MoveCounter, std::string> direct(in_place_ok, 5);
+    ASSERT_EQ(direct.unwrap().value, 5);
+    ASSERT_EQ(MoveCounter::moves + MoveCounter::copies, 0);
+
+    // the lazy wrappers build straight into the converted-to Result
+    Result<MoveCounter, std::string> lazy = ok_in_place(7);
+    ASSERT_EQ(lazy.unwrap().value, 7);
+    ASSERT_EQ(MoveCounter::moves + MoveCounter::copies, 0);
+
+    // make_ok skips the `Ok<T>` temporary, a single move remains
+    auto made = make_ok<MoveCounter, std::string>(MoveCounter{9});
+    ASSERT_EQ(made.unwrap().value, 9);
+    ASSERT_EQ(MoveCounter::moves, 1);
+    ASSERT_EQ(MoveCounter::copies, 0);
+
+    // map constructs the mapped value in place
+    MoveCounter::reset();
+    auto mapped = make_ok<int, std::string>(3).map(
+        [](int v)
+        {
+            return MoveCounter{v * 2};
+        });
+    ASSERT_EQ(mapped.unwrap().value, 6);
+    ASSERT_EQ(MoveCounter::moves + MoveCounter::copies, 0);
+
+    // emplace switches alternatives
+    auto &err = direct.emplace_err(3, '!');
+    ASSERT(direct.is_err());
+    ASSERT_EQ(err, "!!!"s);
+    MoveCounter::reset();
+    direct.emplace_ok(11);
+    ASSERT_EQ(direct.unwrap().value, 11);
+    ASSERT_EQ(MoveCounter::moves + MoveCounter::copies, 0);
+
+    // lvalue arguments are copied, not moved from
+    std::string reason                = "kept";
+    Result<int, std::string> rejected = err_in_place(reason);
+    ASSERT_EQ(rejected.unwrap_err(), "kept"s);
+    ASSERT_EQ(reason, "kept"s);
+
+    Result<void, std::string> void_err(in_place_err, 2, '?');
+    ASSERT_EQ(void_err.unwrap_err(), "??"s);
+    void_err.emplace_ok();
+    ASSERT(void_err.is_ok());
+    Result<void, std::string> void_ok = ok_in_place();
+    ASSERT(void_ok.is_ok());
+}
+
+TEST(niche_layout)
+{
+    static_assert(sizeof(Result<Widget *, Missing>) == sizeof(Widget *));
+    static_assert(sizeof(Result<Node *, Missing>) == sizeof(Node *));
+    static_assert(sizeof(Result<std::unique_ptr<int>, Missing>) == sizeof(std::unique_ptr<int>));
+    static_assert(sizeof(Result<void, Status>) == sizeof(Status));
+    static_assert(std::is_trivially_copyable_v<Result<Widget *, Missing>>);
+    static_assert(std::is_trivially_copyable_v<Result<void, Status>>);
+    static_assert(!std::is_copy_constructible_v<Result<std::unique_ptr<int>, Missing>>);
+
+    // no niche without a stateless other side
+    static_assert(sizeof(Result<Widget *, std::string>) > sizeof(std::string));
+
+    Widget widget{7};
+    Result<Widget *, Missing> found   = Ok(&widget);
+    Result<Widget *, Missing> missing = Err(Missing{});
+    ASSERT(found.is_ok());
+    ASSERT_EQ(found.unwrap()->id, 7);
+    ASSERT(missing.is_err());
+    auto missing_id = missing.map(
+        [](Widget *w)
+        {
+            return w->id;
+        });
+    ASSERT_EQ(missing_id.unwrap_or(-1), -1);
+
+    missing = Ok(&widget);
+    found   = Err(Missing{});
+    ASSERT(missing.is_ok());
+    ASSERT(found.is_err());
+
+    // the misaligned niche keeps `nullptr` a valid payload
+    Result<Node *, Missing> tail = Ok<Node *>(nullptr);
+    ASSERT(tail.is_ok());
+    ASSERT(tail.unwrap() == nullptr);
+    tail = Err(Missing{});
+    ASSERT(tail.is_err());
+
+    auto owned = make_ok<std::unique_ptr<int>, Missing>(std::make_unique<int>(5));
+    auto moved = std::move(owned);
+    ASSERT(moved.is_ok());
+    ASSERT_EQ(*moved.unwrap(), 5);
+    ASSERT((make_err<std::unique_ptr<int>, Missing>(Missing{}).is_err()));
+
+    Result<void, Status> closed = Err(Status::Closed);
+    ASSERT(closed.is_err());
+    ASSERT(closed.unwrap_err() == Status::Closed);
+    closed = Ok();
+    ASSERT(closed.is_ok());
+    closed.unwrap();
+    ASSERT((make_ok<void, Status>().is_ok()));
+
+    // emplacing constructs in place rather than assigning a temporary
+    static_assert(sizeof(Result<Pinned, Missing>) == sizeof(Pinned));
+    auto pinned         = make_ok<Pinned, Missing>(Pinned{1});
+    Pinned::assignments = 0;
+    ASSERT_EQ(pinned.emplace_ok(2).id, 2);
+    ASSERT_EQ(pinned.unwrap().id, 2);
+    pinned.emplace_err();
+    ASSERT(pinned.is_err());
+    pinned.emplace_ok(3);
+    ASSERT(pinned.is_ok());
+    ASSERT_EQ(pinned.unwrap().id, 3);
+    ASSERT_EQ(Pinned::assignments, 0);
+}
+
+TEST(lazy_panic)
+{
+    FormatCounter::formats = 0;
+    auto err               = make_err<int, FormatCounter>(FormatCounter{7});
+
+    try
+    {
+        (void)err.unwrap();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const panic_error &)
+    {
+        // caught and discarded, the payload is never formatted
+    }
+    ASSERT_EQ(FormatCounter::formats, 0);
+
+    try
+    {
+        (void)err.unwrap();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const std::runtime_error &e)
+    {
+        const std::string message = e.what();
+        ASSERT(message.find("called `Result::unwrap()` on an `Err` value format-counter: 7") != std::string::npos);
+        ASSERT(message.rfind("PANIC: [", 0) == 0);
+        ASSERT_EQ(message.back(), '\n');
+
+        // formatted once, then cached
+        ASSERT(std::strcmp(e.what(), message.c_str()) == 0);
+        ASSERT_EQ(FormatCounter::formats, 1);
+    }
+
+    // the payload is a copy, it outlives the `Result` that panicked
+    try
+    {
+        make_err<void, FormatCounter>(FormatCounter{9}).unwrap();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const panic_error &e)
+    {
+        ASSERT(std::string{e.what()}.find("format-counter: 9") != std::string::npos);
+        ASSERT_EQ(e.location().fn_name, "unwrap"sv);
+    }
+
+    // payloads that cannot be copied are formatted before throwing
+    try
+    {
+        panic("moved out: ", NonCopyable{3});
+    }
+    catch (const panic_error &e)
+    {
+        ASSERT(std::string{e.what()}.find("moved out: val: 3") != std::string::npos);
+    }
+
+    // sliced right away, as a `catch (std::runtime_error)` by value would, the
+    // base only holds a fixed note
+    FormatCounter::formats = 0;
+    try
+    {
+        (void)err.unwrap();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const std::runtime_error &e)
+    {
+        const std::runtime_error sliced = e;
+        ASSERT_EQ(std::string{sliced.what()}, "panic (caught by value; catch panic_error by reference)"s);
+        ASSERT_EQ(FormatCounter::formats, 0);
+    }
+
+    // a copy, e.g. by an `std::exception_ptr` that copies, carries the full
+    // message in its base
+    const detail::eager_panic_error original{fmt_source_loc{}, "copied payload"};
+    const detail::eager_panic_error copy = original;
+    const std::runtime_error sliced      = copy;
+    ASSERT(std::string{sliced.what()}.find("copied payload") != std::string::npos);
+    ASSERT(std::strcmp(sliced.what(), copy.what()) == 0);
+}
+
+// renders `value` through `result_debug` the way a panic message would
+template <typename T> std::string debug_string(const T &value)
+{
+    char buffer[128];
+    debug_sink sink{buffer, sizeof(buffer)};
+    debug_write(sink, value);
+    return std::string{sink.view()};
+}
+
+TEST(debug_formatting)
+{
+    // built in
+    ASSERT_EQ(debug_string(42), "42"s);
+    ASSERT_EQ(debug_string(-1.5), "-1.5"s);
+    ASSERT_EQ(debug_string(true), "true"s);
+    ASSERT_EQ(debug_string('x'), "x"s);
+    ASSERT_EQ(debug_string("text"sv), "text"s);
+    ASSERT_EQ(debug_string(static_cast<Widget *>(nullptr)), "0x0"s);
+
+    // ADL `to_chars`, explicit specialization, `operator<<`
+    ASSERT_EQ(debug_string(Millis{250}), "250ms"s);
+    ASSERT_EQ(debug_string(Handle{"db"}), "handle:db"s);
+    ASSERT_EQ(debug_string(ErrCode::Invalid), "ErrCode(2)"s);
+
+    // enums without `operator<<`, debuggable with or without `<ostream>`
+    ASSERT_EQ(debug_string(NoMemory), "12"s);
+    const auto no_entry = make_err<int, Errno>(NoEntry);
+    ASSERT_EQ(no_entry.unwrap_err(), NoEntry);
+    // the conversion to `int` would be streamable, but only with `<ostream>` included
+    ASSERT(!is_debuggable_v<Countdown>);
+
+    // inserter templates, the user's and the standard library's
+    ASSERT_EQ(debug_string(Box<int>{4}), "box(4)"s);
+    ASSERT_EQ(debug_string(std::complex<double>{1.5, -2}), "(1.5,-2)"s);
+    const Result<Box<int>, int> boxed               = Ok(Box<int>{4});
+    const Result<std::complex<double>, int> complex = Ok(std::complex<double>{3});
+    ASSERT_EQ(boxed.unwrap().content, 4);
+    ASSERT_EQ(complex.unwrap().real(), 3.0);
+
+    // ranges of debuggable values
+    ASSERT_EQ(debug_string(std::vector<int>{1, 2, 3}), "[1, 2, 3]"s);
+    ASSERT_EQ(debug_string(std::vector<std::vector<Millis>>{{}, {Millis{1}}}), "[[], [1ms]]"s);
+
+    // opaque fallback
+    Socket socket{3};
+    const std::string opaque = debug_string(socket);
+    ASSERT(opaque.rfind("<Socket @ 0x", 0) == 0);
+    ASSERT_EQ(opaque.back(), '>');
+
+    ASSERT(is_debuggable_v<Millis>);
+    ASSERT(is_debuggable_v<const Handle>);
+    ASSERT(!is_debuggable_v<Silent>);
+    ASSERT(!is_debuggable_v<std::vector<Silent>>);
+
+    // output that does not fit is dropped
+    char small[4];
+    debug_sink sink{small, sizeof(small)};
+    debug_write(sink, "truncated"sv);
+    ASSERT_EQ(sink.view(), "trun"sv);
+    ASSERT(sink.truncated());
+
+    // panics go through the same trait
+    try
+    {
+        make_err<int, Millis>(Millis{5}).unwrap();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const panic_error &e)
+    {
+        ASSERT(std::string{e.what()}.find("`Err` value 5ms") != std::string::npos);
+    }
+}
+
+TEST(lazy_pipeline)
+{
+    auto half = [](int x) -> Result<int, std::string>
+    {
+        if (x % 2 != 0)
+        {
+            return Err("odd"s);
+        }
+        return Ok(x / 2);
+    };
+    auto add_one = [](int x)
+    {
+        return x + 1;
+    };
+    auto recover = [](const std::string &err) -> Result<int, std::size_t>
+    {
+        if (err == "odd")
+        {
+            return Ok(-1);
+        }
+        return Err(err.size());
+    };
+
+    // same outcome as the eager member functions, on every path
+    for (int start : {8, 6, 3})
+    {
+        auto source = make_ok<int, std::string>(start);
+        auto eager  = source.and_then(half).map(add_one).and_then(half).or_else(recover);
+        Result<int, std::size_t> lazy_result =
+            source | lazy::and_then(half) | lazy::map(add_one) | lazy::and_then(half) | lazy::or_else(recover);
+
+        ASSERT_EQ(lazy_result.is_ok(), eager.is_ok());
+        ASSERT(lazy_result.is_ok() ? lazy_result.unwrap() == eager.unwrap()
+                                   : lazy_result.unwrap_err() == eager.unwrap_err());
+    }
+
+    // nothing runs before evaluation
+    int calls     = 0;
+    auto counting = [&calls](int x)
+    {
+        ++calls;
+        return x;
+    };
+    auto one     = make_ok<int, std::string>(1);
+    auto pending = one | lazy::map(counting) | lazy::map(counting);
+    ASSERT_EQ(calls, 0);
+    ASSERT_EQ(std::move(pending).eval().unwrap(), 1);
+    ASSERT_EQ(calls, 2);
+
+    // errors skip value stages and go through `map_err`
+    auto failed = (make_err<int, std::string>("bad"s) | lazy::map(counting) |
+                   lazy::map_err(
+                       [](std::string err)
+                       {
+                           return err.size();
+                       }))
+                      .eval();
+    ASSERT_EQ(failed.unwrap_err(), 3u);
+    ASSERT_EQ(calls, 2);
+
+    // `Result<void, E>` sources and `void` returning stages
+    auto from_void = (make_ok<void, std::string>() |
+                      lazy::map(
+                          []
+                          {
+                              return 5;
+                          }) |
+                      lazy::map([](int) {}))
+                         .eval();
+    ASSERT(from_void.is_ok());
+    static_assert(std::is_same_v<decltype(from_void), Result<void, std::string>>);
+
+    // stages compose ahead of time, an lvalue source is neither copied nor moved
+    auto twice_plus_one = lazy::map(
+                              [](const MoveCounter &counter)
+                              {
+                                  return counter.value * 2;
+                              }) |
+                          lazy::map(add_one);
+    auto counter        = make_ok<MoveCounter, std::string>(MoveCounter{20});
+    MoveCounter::reset();
+    ASSERT_EQ((counter | twice_plus_one).eval().unwrap(), 41);
+    ASSERT_EQ(MoveCounter::moves + MoveCounter::copies, 0);
+
+    // an rvalue source is moved in, the pipeline outlives the expression
+    auto kept = make_ok<std::string, std::string>("kept alive"s) | lazy::map(
+                                                                     [](const std::string &text)
+                                                                     {
+                                                                         return text.size();
+                                                                     });
+    ASSERT_EQ(std::move(kept).eval().unwrap(), std::size_t{10});
+}
+
+TEST(collect_results)
+{
+    using Parsed = Result<int, std::string>;
+
+    std::vector<Parsed> all_ok{Ok(1), Ok(2), Ok(3)};
+    auto values = try_collect(all_ok);
+    ASSERT(values.is_ok());
+    ASSERT(values.unwrap() == (std::vector<int>{1, 2, 3}));
+
+    std::vector<Parsed> with_err{Ok(1), Err("second"s), Ok(3), Err("fourth"s)};
+    ASSERT_EQ(try_collect(with_err).unwrap_err(), "second"s);
+    ASSERT_EQ(try_collect(with_err.begin(), with_err.begin() + 1).unwrap().size(), std::size_t{1});
+
+    // no `reserve`, no random access, `insert` rather than `emplace_back` is fine too
+    std::list<Parsed> listed{Ok(4), Ok(5)};
+    auto as_list = collect<std::list<int>>(listed);
+    ASSERT(as_list.unwrap() == (std::list<int>{4, 5}));
+    ASSERT(collect<std::list<int>>(std::list<Parsed>{}).unwrap().empty());
+
+    // rvalue ranges and move iterators hand over their values
+    std::vector<Result<std::unique_ptr<int>, std::string>> owned;
+    owned.push_back(Ok(std::make_unique<int>(7)));
+    owned.push_back(Ok(std::make_unique<int>(8)));
+    auto moved = try_collect(std::move(owned));
+    ASSERT_EQ(*moved.unwrap()[1], 8);
+
+    std::vector<Result<std::string, int>> names{Ok("a"s), Ok("b"s)};
+    auto copied = try_collect(names);
+    ASSERT_EQ(copied.unwrap()[0], "a"s);
+    ASSERT_EQ(names[0].unwrap(), "a"s);
+    auto taken = try_collect(std::make_move_iterator(names.begin()), std::make_move_iterator(names.end()));
+    ASSERT_EQ(taken.unwrap()[1], "b"s);
+    ASSERT(names[1].unwrap().empty());
+
+    // into a preallocated buffer
+    int buffer[3] = {};
+    auto end = collect_into(all_ok, std::begin(buffer));
+    ASSERT(end.unwrap() == std::end(buffer));
+    ASSERT_EQ(buffer[2], 3);
+
+    int partial[4] = {};
+    ASSERT_EQ(collect_into(with_err.begin(), with_err.end(), partial).unwrap_err(), "second"s);
+    ASSERT_EQ(partial[0], 1);
+    ASSERT_EQ(partial[1], 0);
+
+    std::vector<int> appended{0};
+    collect_into(listed, std::back_inserter(appended)).unwrap();
+    ASSERT(appended == (std::vector<int>{0, 4, 5}));
+}
+
+TEST(result_buffer)
+{
+    ResultBuffer<int, std::string> buffer;
+    ASSERT(buffer.empty());
+    ASSERT_EQ(buffer.count_ok(0, 0), std::size_t{0});
+
+    // errors at 3, 64 and 129, across bitmap words
+    for (int i = 0; i < 130; ++i)
+    {
+        if (i == 3 || i == 64 || i == 129)
+        {
+            buffer.push_back(make_err<int, std::string>("bad " + std::to_string(i)));
+        }
+        else
+        {
+            buffer.push_back(make_ok<int, std::string>(i * 2));
+        }
+    }
+    ASSERT_EQ(buffer.size(), std::size_t{130});
+    ASSERT_EQ(buffer.count_ok(), std::size_t{127});
+    ASSERT_EQ(buffer.count_err(), std::size_t{3});
+    ASSERT_EQ(buffer.ok_bits_size(), std::size_t{3});
+
+    ASSERT_EQ(buffer.count_ok(0, 130), std::size_t{127});
+    ASSERT_EQ(buffer.count_ok(3, 4), std::size_t{0});
+    ASSERT_EQ(buffer.count_ok(4, 64), std::size_t{60});
+    ASSERT_EQ(buffer.count_ok(60, 70), std::size_t{9});
+
+    ASSERT(buffer.is_ok(0));
+    ASSERT(buffer.is_err(64));
+    ASSERT_EQ(buffer.unwrap(65), 130);
+    ASSERT_EQ(buffer.unwrap_err(129), "bad 129"s);
+    ASSERT_EQ(buffer.get(2).unwrap(), 4);
+    ASSERT_EQ(buffer.get(3).unwrap_err(), "bad 3"s);
+
+    bool panicked = false;
+    try
+    {
+        (void)buffer.unwrap(3);
+    }
+    catch (const panic_error &e)
+    {
+        panicked = std::string{e.what()}.find("`Err` value bad 3") != std::string::npos;
+    }
+    ASSERT(panicked);
+
+    std::size_t visited = 0;
+    std::size_t last    = 0;
+    buffer.for_each_ok(
+        [&](std::size_t index, int &value)
+        {
+            ASSERT(index == 0 || index > last);
+            ASSERT_EQ(value, static_cast<int>(index) * 2);
+            value += 1;
+            last = index;
+            ++visited;
+        });
+    ASSERT_EQ(visited, std::size_t{127});
+    ASSERT_EQ(last, std::size_t{128});
+    ASSERT_EQ(buffer.values()[1], 3);
+
+    std::vector<std::size_t> failed;
+    std::as_const(buffer).for_each_err(
+        [&](std::size_t index, const std::string &)
+        {
+            failed.push_back(index);
+        });
+    ASSERT(failed == (std::vector<std::size_t>{3, 64, 129}));
+
+    // from a range of `Result`s, with move only values
+    std::vector<Result<std::unique_ptr<int>, int>> owned;
+    owned.push_back(Ok(std::make_unique<int>(1)));
+    owned.push_back(Err(7));
+    ResultBuffer<std::unique_ptr<int>, int> moved(std::make_move_iterator(owned.begin()),
+                                                  std::make_move_iterator(owned.end()));
+    ASSERT_EQ(*moved.unwrap(0), 1);
+    ASSERT_EQ(moved.unwrap_err(1), 7);
+    ASSERT(moved.values()[1] == nullptr);
+
+    buffer.clear();
+    ASSERT(buffer.empty());
+    ASSERT_EQ(buffer.count_err(), std::size_t{0});
+    buffer.emplace_ok(5);
+    ASSERT_EQ(buffer.count_ok(0, 1), std::size_t{1});
+
+    // a throwing constructor leaves every column as it was
+    ResultBuffer<Picky, int> picky;
+    try
+    {
+        picky.emplace_ok(-1);
+        ASSERT(false); // Should have thrown
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ASSERT(picky.empty());
+    ASSERT_EQ(picky.ok_bits_size(), std::size_t{0});
+    picky.emplace_err(7);
+    ASSERT(picky.is_err(0));
+    ASSERT_EQ(picky.count_ok(), std::size_t{0});
+    ASSERT_EQ(picky.count_ok(0, 1), std::size_t{0});
+    ASSERT_EQ(picky.ok_bits_size(), std::size_t{1});
+
+    ResultBuffer<int, Picky> picky_err;
+    picky_err.emplace_ok(1);
+    try
+    {
+        picky_err.emplace_err(-1);
+        ASSERT(false); // Should have thrown
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+    ASSERT_EQ(picky_err.size(), std::size_t{1});
+    ASSERT_EQ(picky_err.count_err(), std::size_t{0});
+    picky_err.emplace_err(2);
+    ASSERT_EQ(picky_err.unwrap_err(1).value, 2);
+}
+
+// all `Ok` in the first 64 elements, all `Err` in the next 64, then mixed
+template <typename T> ResultBuffer<T, int> batch_input(std::size_t count)
+{
+    ResultBuffer<T, int> buffer;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool ok = i < 64 || (i >= 128 && i % 3 != 0);
+        if (ok)
+        {
+            buffer.emplace_ok(static_cast<T>(i % 100));
+        }
+        else
+        {
+            buffer.emplace_err(static_cast<int>(i));
+        }
+    }
+    return buffer;
+}
+
+template <typename T, bool Pure = false> bool batch_map_matches(batch_isa isa, std::size_t count)
+{
+    auto twice_plus_one = [](T value)
+    {
+        return static_cast<T>(value * 2 + 1);
+    };
+    ResultBuffer<T, int> batch  = batch_input<T>(count);
+    ResultBuffer<T, int> single = batch_input<T>(count);
+    if constexpr (Pure)
+    {
+        batch_map(batch, batch_pure(twice_plus_one), isa);
+    }
+    else
+    {
+        batch_map(batch, twice_plus_one, isa);
+    }
+    single.for_each_ok(
+        [&](std::size_t, T &value)
+        {
+            value = twice_plus_one(value);
+        });
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (batch.is_ok(i) != single.is_ok(i) || batch.values()[i] != single.values()[i] ||
+            (batch.is_err(i) && batch.unwrap_err(i) != static_cast<int>(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(batch_map)
+{
+    // every kernel the CPU has, over full words and a partial last one
+    for (batch_isa isa : {batch_isa::scalar, batch_isa::sse2, batch_isa::avx2, batch_isa::avx512})
+    {
+        for (std::size_t count : {std::size_t{0}, std::size_t{50}, std::size_t{256}, std::size_t{300}})
+        {
+            ASSERT(batch_map_matches<float>(isa, count));
+            ASSERT(batch_map_matches<double>(isa, count));
+            ASSERT(batch_map_matches<long double>(isa, count));
+            ASSERT((batch_map_matches<float, true>(isa, count)));
+            ASSERT((batch_map_matches<double, true>(isa, count)));
+            ASSERT((batch_map_matches<long double, true>(isa, count)));
+            ASSERT(batch_map_matches<std::int32_t>(isa, count));
+            ASSERT(batch_map_matches<std::uint64_t>(isa, count));
+            ASSERT(batch_map_matches<std::int16_t>(isa, count));
+        }
+    }
+
+    // `Err` slots are left alone even where a pure `fn` runs on them
+    ResultBuffer<float, int> zeros;
+    zeros.emplace_err(1);
+    zeros.emplace_ok(1.0f);
+    batch_map(zeros, batch_pure(
+                         [](float value)
+                         {
+                             return value + 10.0f;
+                         }));
+    ASSERT_EQ(zeros.values()[0], 0.0f);
+    ASSERT_EQ(zeros.unwrap(1), 11.0f);
+
+    // without `batch_pure`, `fn` never sees an `Err` slot, not even in a mixed word
+    for (batch_isa isa : {batch_isa::scalar, batch_isa::sse2, batch_isa::avx2, batch_isa::avx512})
+    {
+        ResultBuffer<double, int> mixed = batch_input<double>(300);
+        std::size_t mixed_calls         = 0;
+        batch_map(
+            mixed,
+            [&mixed_calls](double value)
+            {
+                ++mixed_calls;
+                return value + 1;
+            },
+            isa);
+        ASSERT_EQ(mixed_calls, mixed.count_ok());
+
+        ResultBuffer<std::int32_t, int> divisors;
+        for (std::int32_t i = 0; i < 130; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                divisors.emplace_err(static_cast<int>(i));
+            }
+            else
+            {
+                divisors.emplace_ok(i);
+            }
+        }
+        std::size_t calls = 0;
+        batch_map(
+            divisors,
+            [&calls](std::int32_t value)
+            {
+                ++calls;
+                return 1000 / value;
+            },
+            isa);
+        ASSERT_EQ(calls, divisors.count_ok());
+        ASSERT_EQ(divisors.unwrap(1), 1000);
+        ASSERT_EQ(divisors.unwrap(128), 7);
+        ASSERT_EQ(divisors.values()[0], 0);
+    }
+
+    std::vector<Result<float, int>> results;
+    for (int i = 0; i < 150; ++i)
+    {
+        results.push_back(i % 4 == 0 ? make_err<float, int>(i) : make_ok<float, int>(static_cast<float>(i)));
+    }
+    batch_map(results.data(), results.size(),
+              [](float value)
+              {
+                  return value / 2;
+              });
+    ASSERT_EQ(results[1].unwrap(), 0.5f);
+    ASSERT_EQ(results[149].unwrap(), 74.5f);
+    ASSERT_EQ(results[148].unwrap_err(), 148);
+}
+
+TEST(parallel_algorithms)
+{
+    std::vector<int> input(10000);
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<int>(i);
+    }
+    auto halve = [](int value) -> Result<int, std::string>
+    {
+        if (value == 301 || value == 7001)
+        {
+            return Err("odd " + std::to_string(value));
+        }
+        return Ok(value / 2);
+    };
+
+    std::vector<int> output(input.size());
+    parallel::options four{4, 100};
+    ASSERT(parallel::try_transform(input.begin(), input.begin() + 300, output.begin(), halve, four).is_ok());
+    ASSERT_EQ(output[299], 149);
+
+    // the element a sequential loop stops at, however the chunks are scheduled
+    for (int run = 0; run < 20; ++run)
+    {
+        auto failed = parallel::try_transform(input.begin(), input.end(), output.begin(), halve, four);
+        ASSERT_EQ(failed.unwrap_err(), "odd 301"s);
+    }
+    parallel::options first_seen{4, 100, parallel::error_order::first_observed};
+    const std::string seen =
+        parallel::try_transform(input.begin(), input.end(), output.begin(), halve, first_seen).unwrap_err();
+    ASSERT(seen == "odd 301"s || seen == "odd 7001"s);
+
+    // on one worker, nothing runs past the failing element
+    std::atomic<std::size_t> calls{0};
+    auto counted = [&](int value)
+    {
+        ++calls;
+        return halve(value);
+    };
+    ASSERT(parallel::try_for_each(input.begin(), input.end(), counted, {1, 64}).is_err());
+    ASSERT_EQ(calls.load(), std::size_t{302});
+
+    calls = 0;
+    ASSERT(parallel::try_for_each(input.begin(), input.begin() + 301, counted).is_ok());
+    ASSERT_EQ(calls.load(), std::size_t{301});
+    ASSERT(parallel::try_for_each(input.begin(), input.begin(), counted).is_ok());
+
+    // the same on the workers of an executor, from outside it and from one of its tasks
+    Executor executor{3};
+    parallel::options pooled{0, 100};
+    pooled.executor = &executor;
+    for (int run = 0; run < 20; ++run)
+    {
+        auto failed = parallel::try_transform(input.begin(), input.end(), output.begin(), halve, pooled);
+        ASSERT_EQ(failed.unwrap_err(), "odd 301"s);
+    }
+    ASSERT(parallel::try_transform(input.begin(), input.begin() + 300, output.begin(), halve, pooled).is_ok());
+    ASSERT_EQ(output[299], 149);
+    auto nested = executor.spawn(
+        [&]
+        {
+            return parallel::try_for_each(input.begin(), input.end(), halve, pooled);
+        });
+    ASSERT_EQ(nested.join().unwrap_err(), "odd 301"s);
+}
+
+// sum of [first, last), split into subtasks down to 64 elements, failing on
+// a negative element
+Result<long, std::string> split_sum(Executor &executor, const std::vector<int> &values, std::size_t first,
+                                    std::size_t last)
+{
+    if (last - first <= 64)
+    {
+        long sum = 0;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            if (values[i] < 0)
+            {
+                return Err("negative at " + std::to_string(i));
+            }
+            sum += values[i];
+        }
+        return Ok(sum);
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    auto left                = executor.spawn(
+        [&executor, &values, first, middle]
+        {
+            return split_sum(executor, values, first, middle);
+        });
+    auto right               = split_sum(executor, values, middle, last);
+    auto sum                 = left.join();
+    if (sum.is_err())
+    {
+        return sum;
+    }
+    if (right.is_err())
+    {
+        return right;
+    }
+    return Ok(sum.unwrap() + right.unwrap());
+}
+
+TEST(executor)
+{
+    Executor executor{4};
+    ASSERT_EQ(executor.threads(), std::size_t{4});
+
+    auto answer = executor.spawn([] { return Result<int, std::string>{Ok(42)}; });
+    ASSERT(answer.valid());
+    ASSERT_EQ(answer.join().unwrap(), 42);
+    ASSERT(!answer.valid());
+
+    auto failed = executor.spawn([]() -> Result<int, std::string> { return Err("no"s); });
+    ASSERT_EQ(failed.join().unwrap_err(), "no"s);
+
+    // the first `Err` by position, or every one of them
+    auto squares = [&](std::vector<int> failing)
+    {
+        std::vector<Task<int, std::string>> tasks;
+        for (int i = 0; i < 100; ++i)
+        {
+            const bool fails = std::find(failing.begin(), failing.end(), i) != failing.end();
+            tasks.push_back(executor.spawn(
+                [i, fails]() -> Result<int, std::string>
+                {
+                    if (fails)
+                    {
+                        return Err("task " + std::to_string(i));
+                    }
+                    return Ok(i * i);
+                }));
+        }
+        return tasks;
+    };
+    auto all_ok = squares({});
+    auto values = join_all(all_ok).unwrap();
+    ASSERT_EQ(values.size(), std::size_t{100});
+    ASSERT_EQ(values[99], 9801);
+    ASSERT(!all_ok[0].valid());
+
+    auto some_fail = squares({70, 3, 41});
+    ASSERT_EQ(join_all(some_fail).unwrap_err(), "task 3"s);
+    some_fail = squares({70, 3, 41});
+    ASSERT_EQ(join_all_errors(some_fail).unwrap_err(),
+              (std::vector<std::string>{"task 3"s, "task 41"s, "task 70"s}));
+    auto none_fail = squares({});
+    ASSERT_EQ(join_all_errors(none_fail).unwrap()[10], 100);
+
+    std::atomic<int> ran{0};
+    std::vector<Task<void, int>> side_effects;
+    for (int i = 0; i < 10; ++i)
+    {
+        side_effects.push_back(executor.spawn(
+            [&ran, i]() -> Result<void, int>
+            {
+                ++ran;
+                if (i % 4 == 1)
+                {
+                    return Err(i);
+                }
+                return Ok();
+            }));
+    }
+    ASSERT_EQ(join_all_errors(side_effects).unwrap_err(), (std::vector<int>{1, 5, 9}));
+    ASSERT_EQ(ran.load(), 10);
+
+    // tasks joining their own subtasks, on few workers and on one
+    std::vector<int> numbers(10000);
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+    {
+        numbers[i] = static_cast<int>(i % 100);
+    }
+    ASSERT_EQ(split_sum(executor, numbers, 0, numbers.size()).unwrap(), 495000L);
+    {
+        Executor single{1};
+        auto whole = single.spawn([&] { return split_sum(single, numbers, 0, numbers.size()); });
+        ASSERT_EQ(whole.join().unwrap(), 495000L);
+        numbers[6789] = -1;
+        ASSERT_EQ(split_sum(single, numbers, 0, numbers.size()).unwrap_err(), "negative at 6789"s);
+    }
+
+    // dropped handles still run, before the executor goes
+    std::atomic<int> detached{0};
+    {
+        Executor pool{2};
+        for (int i = 0; i < 50; ++i)
+        {
+            (void)pool.spawn(
+                [&detached]() -> Result<void, int>
+                {
+                    ++detached;
+                    return Ok();
+                });
+        }
+    }
+    ASSERT_EQ(detached.load(), 50);
+
+    // and a handle kept past its executor can still be joined
+    Task<int, std::string> outlived;
+    {
+        Executor pool{2};
+        outlived = pool.spawn(
+            []() -> Result<int, std::string>
+            {
+                return Ok(7);
+            });
+    }
+    ASSERT(outlived.is_ready());
+    ASSERT_EQ(outlived.join().unwrap(), 7);
+}
+
+TEST(result_future)
+{
+    ResultPromise<int, std::string> promise;
+    ResultFuture<int, std::string> future = promise.get_future();
+    ASSERT(future.valid());
+    ASSERT(!future.is_ready());
+    ASSERT(!future.try_get().has_value());
+    promise.set_result(Ok(7));
+    ASSERT(future.is_ready());
+    ASSERT_EQ(future.try_get().value().unwrap(), 7);
+    ASSERT(!future.valid());
+
+    try
+    {
+        promise.set_result(Ok(8));
+        ASSERT(false); // Should have thrown
+    }
+    catch (const panic_error &)
+    {
+        // set twice
+    }
+
+    // handed to another thread, waited for
+    for (int run = 0; run < 50; ++run)
+    {
+        ResultPromise<std::string, int> sender;
+        auto received = sender.get_future();
+        std::thread producer{[sender = std::move(sender), run]() mutable
+                             {
+                                 sender.set_result(run % 2 == 0 ? Result<std::string, int>{Ok("even"s)}
+                                                                : Result<std::string, int>{Err(run)});
+                             }};
+        auto result = received.get();
+        producer.join();
+        ASSERT(run % 2 == 0 ? result.unwrap() == "even"s : result.unwrap_err() == run);
+    }
+
+    // `then` before completion runs on the completing thread, after it at once
+    ResultPromise<int, std::string> later;
+    std::thread::id ran_on;
+    auto doubled = later.get_future().then(
+        [&ran_on](int value) -> Result<int, std::string>
+        {
+            ran_on = std::this_thread::get_id();
+            return Ok(value * 2);
+        });
+    std::thread completer{[&later] { later.set_result(Ok(21)); }};
+    const std::thread::id completer_id = completer.get_id();
+    completer.join();
+    ASSERT_EQ(doubled.get().unwrap(), 42);
+    ASSERT(ran_on == completer_id);
+
+    ResultPromise<int, std::string> done;
+    auto done_future = done.get_future();
+    done.set_result(Ok(5));
+    auto described = done_future.then(
+        [](int value) -> Result<std::string, std::string>
+        {
+            return Ok(std::to_string(value));
+        });
+    ASSERT(!done_future.valid());
+    ASSERT_EQ(described.try_get().value().unwrap(), "5"s);
+
+    int calls = 0;
+    ResultPromise<void, std::string> failing;
+    auto skipped = failing.get_future().then(
+        [&calls]() -> Result<int, std::string>
+        {
+            ++calls;
+            return Ok(1);
+        });
+    failing.set_result(Err("no"s));
+    ASSERT_EQ(skipped.get().unwrap_err(), "no"s);
+    ASSERT_EQ(calls, 0);
+
+    // an abandoned promise wakes its future, which panics, and its chain
+    ResultFuture<int, std::string> orphan;
+    ResultFuture<int, std::string> chained;
+    {
+        ResultPromise<int, std::string> dropped;
+        ResultPromise<int, std::string> dropped_too;
+        orphan  = dropped.get_future();
+        chained = dropped_too.get_future().then(
+            [](int value) -> Result<int, std::string>
+            {
+                return Ok(value);
+            });
+    }
+    ASSERT(orphan.is_ready());
+    ASSERT(chained.is_ready());
+    try
+    {
+        (void)orphan.get();
+        ASSERT(false); // Should have thrown
+    }
+    catch (const panic_error &e)
+    {
+        ASSERT(std::string{e.what()}.find("abandoned `ResultPromise`") != std::string::npos);
+    }
+}
+
+#if defined(__cpp_impl_coroutine)
+Result<int, std::string> co_parse(int value)
+{
+    if (value < 0)
+    {
+        co_return Err("negative"s);
+    }
+    co_return value;
+}
+
+Result<int, std::string> co_double(int value)
+{
+    int parsed = co_await co_parse(value);
+    co_return Ok(parsed * 2);
+}
+
+Result<void, std::string> co_check(int value)
+{
+    co_await co_double(value);
+    co_return Ok();
+}
+
+// a narrower error type converts on the way out
+Result<long, std::string> co_widen(const Result<int, const char *> &input)
+{
+    const int &value = co_await input;
+    co_return static_cast<long>(value);
+}
+
+Result<NonCopyable, std::string> co_move_only(int value)
+{
+    NonCopyable moved = co_await make_ok<NonCopyable, std::string>(NonCopyable{value});
+    co_return std::move(moved);
+}
+
+Result<int, std::string> co_throws()
+{
+    co_await co_parse(1);
+    throw std::runtime_error("thrown inside");
+}
+
+TEST(coroutine_propagation)
+{
+    ASSERT_EQ(co_double(21).unwrap(), 42);
+    ASSERT_EQ(co_double(-1).unwrap_err(), "negative"s);
+
+    ASSERT(co_check(1).is_ok());
+    ASSERT_EQ(co_check(-1).unwrap_err(), "negative"s);
+
+    ASSERT_EQ(co_widen(make_ok<int, const char *>(7)).unwrap(), 7L);
+    ASSERT_EQ(co_widen(make_err<int, const char *>("narrow")).unwrap_err(), "narrow"s);
+
+    ASSERT_EQ(co_move_only(5).unwrap().value, 5);
+
+    bool caught = false;
+    try
+    {
+        (void)co_throws();
+    }
+    catch (const std::runtime_error &e)
+    {
+        caught = std::string{e.what()} == "thrown inside";
+    }
+    ASSERT(caught);
+}
+#endif
+
+#if defined(__x86_64__) && !defined(_WIN32)
+// SysV returns trivially copyable aggregates of up to 16 bytes in RAX:RDX
+struct RegisterPair
+{
+    std::uint64_t rax;
+    std::uint64_t rdx;
+};
+
+[[gnu::noinline]] Result<int, int> abi_return_int(int value) { return make_ok<int, int>(value); }
+[[gnu::noinline]] Result<std::int64_t, std::int64_t> abi_return_int64(std::int64_t value)
+{
+    return make_err<std::int64_t, std::int64_t>(value);
+}
+[[gnu::noinline]] Result<void, ErrCode> abi_return_void(ErrCode code) { return make_err<void, ErrCode>(code); }
+
+// Calls `fn` through a signature that is known to come back in RAX:RDX and
+// rebuilds the `Result` from those registers. Were the `Result` returned
+// through memory, `arg` would land in the hidden pointer register and the
+// callee would fault instead.
+template <typename R, typename Arg> R call_through_registers(R (*fn)(Arg), Arg arg)
+{
+    static_assert(sizeof(R) <= sizeof(RegisterPair));
+    auto as_registers = reinterpret_cast<RegisterPair (*)(Arg)>(reinterpret_cast<void (*)()>(fn));
+    RegisterPair regs = as_registers(arg);
+    alignas(R) unsigned char bytes[sizeof(R)];
+    std::memcpy(bytes, &regs, sizeof(R));
+    return *std::launder(reinterpret_cast<R *>(bytes));
+}
+
+TEST(register_return_abi)
+{
+    auto ok = call_through_registers(&abi_return_int, 42);
+    ASSERT(ok.is_ok());
+    ASSERT_EQ(ok.unwrap(), 42);
+
+    auto wide = call_through_registers(&abi_return_int64, std::int64_t{-7});
+    ASSERT(wide.is_err());
+    ASSERT_EQ(wide.unwrap_err(), -7);
+
+    auto void_err = call_through_registers(&abi_return_void, ErrCode::Invalid);
+    ASSERT(void_err.is_err());
+    ASSERT(void_err.unwrap_err() == ErrCode::Invalid);
+}
+#endif
+
 void run_all_tests()
 {
     std::cout << "=== Running Result<T, E> Test Suite ===\n\n";
@@ -984,6 +2393,24 @@ void run_all_tests()
     run_test_type_traits_and_constraints();
     run_test_edge_cases();
     run_test_constexpr_operations();
+    run_test_trivial_storage();
+    run_test_in_place_construction();
+    run_test_niche_layout();
+    run_test_lazy_panic();
+    run_test_debug_formatting();
+    run_test_lazy_pipeline();
+    run_test_collect_results();
+    run_test_result_buffer();
+    run_test_batch_map();
+    run_test_parallel_algorithms();
+    run_test_executor();
+    run_test_result_future();
+#if defined(__cpp_impl_coroutine)
+    run_test_coroutine_propagation();
+#endif
+#if defined(__x86_64__) && !defined(_WIN32)
+    run_test_register_return_abi();
+#endif
 
     std::cout << "\n=== Test Results ===\n";
     std::cout << "Passed: " << passed_tests << "/" << test_count << " tests\n";
@@ -1,8 +1,64 @@
 #pragma once
+#include "result-debug.hpp"
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <experimental/source_location>
-#include <sstream>
-#include <stdexcept>
+#include <string_view>
+
+// Panic policies, pick one by defining `RESULT_PANIC_POLICY` before the first
+// include of this library. The policy has to be the same in every translation
+// unit that uses a given `Result` type: the failure paths are separate per
+// policy, the inline members calling them are not.
+//
+//   RESULT_PANIC_THROW    throw `result_type::panic_error`, a `std::runtime_error` that
+//                         formats its message on the first `what()` (default)
+//   RESULT_PANIC_ABORT    write the message to stderr and `std::abort()`
+//                         (default when exceptions are disabled)
+//   RESULT_PANIC_HANDLER  call the handler installed with `set_panic_handler`,
+//                         abort as above if there is none or it returns
+#define RESULT_PANIC_THROW 0
+#define RESULT_PANIC_ABORT 1
+#define RESULT_PANIC_HANDLER 2
+
+#if !defined(RESULT_PANIC_POLICY)
+#    if defined(__cpp_exceptions)
+#        define RESULT_PANIC_POLICY RESULT_PANIC_THROW
+#    else
+#        define RESULT_PANIC_POLICY RESULT_PANIC_ABORT
+#    endif
+#endif
+
+#if RESULT_PANIC_POLICY == RESULT_PANIC_THROW
+#    if !defined(__cpp_exceptions)
+#        error "RESULT_PANIC_THROW needs exceptions, use RESULT_PANIC_ABORT or RESULT_PANIC_HANDLER"
+#    endif
+#    include <memory>
+#    include <stdexcept>
+#    include <string>
+#    include <tuple>
+#    include <type_traits>
+#    define RESULT_PANIC_NS panic_throw
+#elif RESULT_PANIC_POLICY == RESULT_PANIC_ABORT
+#    define RESULT_PANIC_NS panic_abort
+#elif RESULT_PANIC_POLICY == RESULT_PANIC_HANDLER
+#    define RESULT_PANIC_NS panic_handler
+#else
+#    error "unknown RESULT_PANIC_POLICY"
+#endif
+
+#if __has_include(<unistd.h>)
+#    include <unistd.h>
+#    define RESULT_PANIC_HAS_WRITE 1
+#endif
+
+// size of the per-thread buffer panic messages are formatted into, longer
+// messages are truncated
+#if !defined(RESULT_PANIC_BUFFER_SIZE)
+#    define RESULT_PANIC_BUFFER_SIZE 1024
+#endif
 
 #if defined(__cpp_consteval)
 #    define RESULT_COMPTIME consteval
@@ -24,7 +80,9 @@ struct fmt_source_loc
     {
     }
 
-    friend std::ostream &operator<<(std::ostream &oss, const fmt_source_loc &loc)
+    template <typename Char, typename Traits>
+    friend std::basic_ostream<Char, Traits> &operator<<(std::basic_ostream<Char, Traits> &oss,
+                                                        const fmt_source_loc &loc)
     {
         oss << "[" << loc.file_name << ':' << loc.line_num << ':' << loc.fn_name << "]";
         return oss;
@@ -83,15 +141,260 @@ private:
     }
 };
 
-template <typename... Args> struct panic
+namespace result_type
 {
-    panic(Args &&...args, fmt_source_loc const location = std::experimental::source_location::current())
+    template <> struct result_debug<fmt_source_loc>
+    {
+        static void format(debug_sink &sink, const fmt_source_loc &loc) noexcept
+        {
+            sink.put('[');
+            sink.write(loc.file_name);
+            sink.put(':');
+            detail::write_number(sink, loc.line_num);
+            sink.put(':');
+            sink.write(loc.fn_name);
+            sink.put(']');
+        }
+    };
+
+    // called with the formatted message, must not return
+    using panic_handler_t = void (*)(std::string_view message);
+
+    namespace detail
+    {
+        inline std::atomic<panic_handler_t> installed_panic_handler{nullptr};
+
+        [[noreturn]] inline void abort_with(std::string_view message) noexcept
+        {
+#if defined(RESULT_PANIC_HAS_WRITE)
+            while (!message.empty())
+            {
+                const auto written = ::write(STDERR_FILENO, message.data(), message.size());
+                if (written <= 0)
+                {
+                    break;
+                }
+                message.remove_prefix(static_cast<std::size_t>(written));
+            }
+#else
+            std::fwrite(message.data(), 1, message.size(), stderr);
+#endif
+            std::abort();
+        }
+
+        // formats `PANIC: <location> <args...>\n` into the per-thread panic
+        // buffer, truncating whatever does not fit
+        template <typename Writer>
+        std::string_view format_panic(const fmt_source_loc &location, const Writer &write_args)
+        {
+            thread_local char buffer[RESULT_PANIC_BUFFER_SIZE];
+
+            // keep the last byte for the trailing newline
+            debug_sink sink{buffer, sizeof(buffer) - 1};
+            sink.write("PANIC: ");
+            debug_write(sink, location);
+            sink.put(' ');
+            write_args(sink);
+            sink.put('\n');
+
+            std::string_view message = sink.view();
+            if (message.back() != '\n')
+            {
+                buffer[message.size()] = '\n';
+                message                = {buffer, message.size() + 1};
+            }
+            return message;
+        }
+
+        // inline namespace keeps translation units built with different
+        // policies from silently sharing one definition
+        inline namespace RESULT_PANIC_NS
+        {
+#if RESULT_PANIC_POLICY != RESULT_PANIC_THROW
+            [[noreturn]] inline void raise_panic(std::string_view message)
+            {
+#    if RESULT_PANIC_POLICY == RESULT_PANIC_HANDLER
+                if (auto handler = installed_panic_handler.load(std::memory_order_acquire))
+                {
+                    handler(message);
+                }
+#    endif
+                abort_with(message);
+            }
+#endif
+        } // namespace RESULT_PANIC_NS
+    } // namespace detail
+
+#if RESULT_PANIC_POLICY == RESULT_PANIC_THROW
+    // Thrown by `panic` under `RESULT_PANIC_THROW`. Holds copies of the panic
+    // arguments and only formats them on the first `what()`, so a caller that
+    // catches and discards the panic never streams the payload.
+    //
+    // Until the exception is copied, the `std::runtime_error` base only holds
+    // a fixed note, so throwing formats nothing: catching `std::runtime_error`
+    // by value, or slicing the thrown object otherwise, keeps that note instead
+    // of the message. Copying a `panic_error` formats the full message into
+    // the base of the copy, which then slices cleanly.
+    class panic_error : public std::runtime_error
+    {
+    public:
+        panic_error(const panic_error &other)
+            : std::runtime_error{other.what()}, location_{other.location_}, copied_{true}
+        {
+        }
+        panic_error &operator=(const panic_error &) = delete;
+        ~panic_error() override { delete[] message_.load(std::memory_order_relaxed); }
+
+        // formatted once, safe to call from several threads sharing an `std::exception_ptr`
+        const char *what() const noexcept override
+        {
+            if (copied_)
+            {
+                return std::runtime_error::what();
+            }
+            if (const char *message = message_.load(std::memory_order_acquire))
+            {
+                return message;
+            }
+            try
+            {
+                std::string_view formatted = detail::format_panic(location_,
+                                                                  [this](debug_sink &sink)
+                                                                  {
+                                                                      write_args(sink);
+                                                                  });
+                auto owned                 = std::make_unique<char[]>(formatted.size() + 1);
+                formatted.copy(owned.get(), formatted.size());
+                owned[formatted.size()] = '\0';
+
+                const char *expected    = nullptr;
+                if (message_.compare_exchange_strong(expected, owned.get(), std::memory_order_acq_rel))
+                {
+                    return owned.release();
+                }
+                return expected;
+            }
+            catch (...)
+            {
+                return "PANIC: <message could not be formatted>\n";
+            }
+        }
+
+        [[nodiscard]] const fmt_source_loc &location() const noexcept { return location_; }
+
+    protected:
+        explicit panic_error(const fmt_source_loc &location)
+            : std::runtime_error{"panic (caught by value; catch panic_error by reference)"}, location_{location}
+        {
+        }
+
+        virtual void write_args(debug_sink &sink) const = 0;
+
+    private:
+        fmt_source_loc location_;
+        mutable std::atomic<const char *> message_{nullptr};
+        // the base holds the full message
+        bool copied_ = false;
+    };
+
+    namespace detail
+    {
+        // text is copied, a `const char *` may not outlive the throwing frame
+        template <typename Arg>
+        using panic_capture_t = std::conditional_t<std::is_convertible_v<Arg, std::string_view> &&
+                                                       !std::is_same_v<std::decay_t<Arg>, std::string>,
+                                                   std::string, std::decay_t<Arg>>;
+
+        template <typename... Captures> class lazy_panic_error final : public panic_error
+        {
+        public:
+            template <typename... Args>
+            explicit lazy_panic_error(const fmt_source_loc &location, Args &&...args)
+                : panic_error{location}, args_{std::forward<Args>(args)...}
+            {
+            }
+
+        protected:
+            void write_args(debug_sink &sink) const override
+            {
+                std::apply(
+                    [&sink](const auto &...args)
+                    {
+                        (debug_write(sink, args), ...);
+                    },
+                    args_);
+            }
+
+        private:
+            std::tuple<Captures...> args_;
+        };
+
+        // fallback for arguments that cannot be copied into the exception
+        class eager_panic_error final : public panic_error
+        {
+        public:
+            eager_panic_error(const fmt_source_loc &location, std::string text)
+                : panic_error{location}, text_{std::move(text)}
+            {
+            }
+
+        protected:
+            void write_args(debug_sink &sink) const override { sink.write(text_); }
+
+        private:
+            std::string text_;
+        };
+    } // namespace detail
+#endif
+
+    // installs `handler` for `RESULT_PANIC_HANDLER`, returns the previous one
+    inline panic_handler_t set_panic_handler(panic_handler_t handler) noexcept
     {
-        std::ostringstream oss;
-        oss << "PANIC: " << location << ' ';
-        (oss << ... << std::forward<Args>(args));
-        oss << '\n';
-        throw std::runtime_error(std::move(oss).str());
+        return detail::installed_panic_handler.exchange(handler, std::memory_order_acq_rel);
     }
-};
-template <typename... Args> panic(Args &&...) -> panic<Args...>;
+} // namespace result_type
+
+namespace result_type::detail
+{
+    // The failure entry points below, `panic` and `unwrap_failed` (see
+    // result-type-observers.hpp), have a body per policy and so live in the
+    // policy's inline namespace: a translation unit built with another policy
+    // gets its own instantiations instead of whichever one the linker keeps.
+    inline namespace RESULT_PANIC_NS
+    {
+        // Hands its arguments to the configured panic policy. `RESULT_PANIC_THROW`
+        // captures them in a `result_type::panic_error` and formats lazily, the other
+        // policies format into a fixed per-thread buffer, no heap allocation. Kept
+        // cold and out of line so the failure path does not bloat inlined callers.
+        template <typename... Args> struct panic
+        {
+            [[noreturn, gnu::cold, gnu::noinline]] panic(
+                Args &&...args, fmt_source_loc const location = std::experimental::source_location::current())
+            {
+                auto write_args = [&args...](debug_sink &sink)
+                {
+                    (debug_write(sink, args), ...);
+                };
+#if RESULT_PANIC_POLICY == RESULT_PANIC_THROW
+                if constexpr ((std::is_constructible_v<panic_capture_t<Args>, Args &&> && ...) &&
+                              (std::is_copy_constructible_v<panic_capture_t<Args>> && ...))
+                {
+                    throw lazy_panic_error<panic_capture_t<Args>...>{location, std::forward<Args>(args)...};
+                }
+                else
+                {
+                    thread_local char buffer[RESULT_PANIC_BUFFER_SIZE];
+                    debug_sink sink{buffer, sizeof(buffer)};
+                    write_args(sink);
+                    throw eager_panic_error{location, std::string{sink.view()}};
+                }
+#else
+                raise_panic(format_panic(location, write_args));
+#endif
+            }
+        };
+        template <typename... Args> panic(Args &&...) -> panic<Args...>;
+    } // namespace RESULT_PANIC_NS
+} // namespace result_type::detail
+
+using result_type::detail::panic;
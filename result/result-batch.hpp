@@ -0,0 +1,373 @@
+#pragma once
+#include "result-buffer.hpp"
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-observers.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define RESULT_BATCH_X86 1
+#    include <immintrin.h>
+#else
+#    define RESULT_BATCH_X86 0
+#endif
+
+// `map` over many `Result<T, E>` with an arithmetic `T` at once, in place:
+//
+// ``` cpp
+// ResultBuffer<float, DecodeErr> readings = decode_all(frames);
+// batch_map(readings, batch_pure([](float volts) { return volts * gain + offset; }));
+//
+// std::vector<Result<float, DecodeErr>> single = ...;
+// batch_map(single.data(), single.size(), [](float volts) { return volts * gain; });
+// ```
+//
+// On a `ResultBuffer` the values are mapped 64 at a time, one bitmap word,
+// with the vector width of the best instruction set the CPU has: AVX-512,
+// AVX2 or SSE2, picked once at run time. Words without `Ok` elements are
+// skipped and words without `Err` ones are mapped in place. A word with both
+// `Ok` and `Err` elements only has its `Ok` lanes mapped, one at a time,
+// unless `fn` is wrapped in `batch_pure` and `T` is a `float` or `double`:
+// then `fn` runs on every lane, `Err` slots included, and the results are
+// written back under the word as a mask, so `Err` elements keep their value.
+// `batch_pure` promises that this is harmless, no side effects and no trap on
+// whatever an `Err` slot holds, a value-initialized `T` normally. Other targets
+// and compilers run the same loops without the ISA specific code.
+//
+// A plain array of `Result`s interleaves values and tags, which does not
+// vectorize. There `batch_map` is the loop over every element and its tag,
+// for code that has to work with either layout.
+namespace result_type
+{
+    // instruction sets `batch_map` has kernels for, in order
+    enum class batch_isa : std::uint8_t
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512,
+    };
+
+    // the best `batch_isa` the running CPU supports, detected on first use
+    inline batch_isa detected_batch_isa() noexcept
+    {
+#if RESULT_BATCH_X86
+        static const batch_isa isa = []
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return batch_isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return batch_isa::avx2;
+            }
+            return __builtin_cpu_supports("sse2") ? batch_isa::sse2 : batch_isa::scalar;
+        }();
+        return isa;
+#else
+        return batch_isa::scalar;
+#endif
+    }
+} // namespace result_type
+
+namespace result_type::detail
+{
+    constexpr std::size_t batch_lanes = bitmap_word_bits;
+
+    // see `batch_pure`
+    template <typename Fn> struct batch_pure_fn
+    {
+        Fn fn;
+
+        template <typename T> auto operator()(T value) -> decltype(std::declval<Fn &>()(value)) { return fn(value); }
+    };
+
+    template <typename Fn> constexpr bool is_batch_pure                   = false;
+    template <typename Fn> constexpr bool is_batch_pure<batch_pure_fn<Fn>> = true;
+
+    // the commit kernels blend whole lanes of up to 64 bits
+    template <typename T, typename Fn>
+    constexpr bool batch_blends = is_batch_pure<Fn> && std::is_floating_point_v<T> && sizeof(T) <= 8;
+
+    // a fixed trip count, so the loop vectorizes with the instruction set of
+    // the kernel it is inlined into even at -O2
+    template <typename T, typename Fn>
+    [[gnu::always_inline]] inline void map_lanes(const T *values, T *mapped, Fn &fn)
+    {
+        for (std::size_t i = 0; i < batch_lanes; ++i)
+        {
+            mapped[i] = static_cast<T>(fn(values[i]));
+        }
+    }
+    template <typename T, typename Fn> [[gnu::always_inline]] inline void map_lanes_in_place(T *values, Fn &fn)
+    {
+        for (std::size_t i = 0; i < batch_lanes; ++i)
+        {
+            values[i] = static_cast<T>(fn(values[i]));
+        }
+    }
+
+    template <std::size_t Size> struct lane_bits_of;
+    template <> struct lane_bits_of<1>
+    {
+        using type = std::uint8_t;
+    };
+    template <> struct lane_bits_of<2>
+    {
+        using type = std::uint16_t;
+    };
+    template <> struct lane_bits_of<4>
+    {
+        using type = std::uint32_t;
+    };
+    template <> struct lane_bits_of<8>
+    {
+        using type = std::uint64_t;
+    };
+
+    // `values[i] = mapped[i]` where bit `i` of `mask` is set, blending the
+    // bits of both rather than branching on every lane
+    struct commit_scalar
+    {
+        template <typename T> static void lanes(bitmap_word mask, const T *mapped, T *values)
+        {
+            using bits = typename lane_bits_of<sizeof(T)>::type;
+            for (std::size_t i = 0; i < batch_lanes; ++i)
+            {
+                const auto select = static_cast<bits>(0 - static_cast<bits>(mask >> i & 1));
+                bits from;
+                bits to;
+                std::memcpy(&from, mapped + i, sizeof(T));
+                std::memcpy(&to, values + i, sizeof(T));
+                to = static_cast<bits>((from & select) | (to & static_cast<bits>(~select)));
+                std::memcpy(values + i, &to, sizeof(T));
+            }
+        }
+    };
+
+#if RESULT_BATCH_X86
+    struct commit_sse2
+    {
+        // 64 bit lanes compare both their halves, which get the same bit
+        template <typename T> [[gnu::target("sse2")]] static void lanes(bitmap_word mask, const T *mapped, T *values)
+        {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                constexpr std::size_t per_vector = 16 / sizeof(T);
+                const __m128i lane_bits = sizeof(T) == 4 ? _mm_setr_epi32(1, 2, 4, 8) : _mm_setr_epi32(1, 1, 2, 2);
+                for (std::size_t i = 0; i < batch_lanes; i += per_vector)
+                {
+                    const int bits = static_cast<int>(mask >> i & ((1u << per_vector) - 1));
+                    const __m128i select =
+                        _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), lane_bits), lane_bits);
+                    const __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mapped + i));
+                    __m128i *to        = reinterpret_cast<__m128i *>(values + i);
+                    _mm_storeu_si128(to, _mm_or_si128(_mm_and_si128(select, from),
+                                                      _mm_andnot_si128(select, _mm_loadu_si128(to))));
+                }
+            }
+            else
+            {
+                commit_scalar::lanes(mask, mapped, values);
+            }
+        }
+    };
+
+    struct commit_avx2
+    {
+        template <typename T>
+        [[gnu::target("avx2")]] static void lanes(bitmap_word mask, const T *mapped, T *values)
+        {
+            if constexpr (sizeof(T) == 4 || sizeof(T) == 8)
+            {
+                constexpr std::size_t per_vector = 32 / sizeof(T);
+                const __m256i lane_bits          = sizeof(T) == 4 ? _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128)
+                                                                  : _mm256_setr_epi32(1, 1, 2, 2, 4, 4, 8, 8);
+                for (std::size_t i = 0; i < batch_lanes; i += per_vector)
+                {
+                    const int bits = static_cast<int>(mask >> i & ((1u << per_vector) - 1));
+                    const __m256i select =
+                        _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), lane_bits), lane_bits);
+                    _mm256_maskstore_epi32(reinterpret_cast<int *>(values + i), select,
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mapped + i)));
+                }
+            }
+            else
+            {
+                commit_scalar::lanes(mask, mapped, values);
+            }
+        }
+    };
+
+    struct commit_avx512
+    {
+        template <typename T>
+        [[gnu::target("avx512f")]] static void lanes(bitmap_word mask, const T *mapped, T *values)
+        {
+            if constexpr (sizeof(T) == 4)
+            {
+                for (std::size_t i = 0; i < batch_lanes; i += 16)
+                {
+                    _mm512_mask_storeu_epi32(values + i, static_cast<__mmask16>(mask >> i),
+                                             _mm512_loadu_si512(mapped + i));
+                }
+            }
+            else if constexpr (sizeof(T) == 8)
+            {
+                for (std::size_t i = 0; i < batch_lanes; i += 8)
+                {
+                    _mm512_mask_storeu_epi64(values + i, static_cast<__mmask8>(mask >> i),
+                                             _mm512_loadu_si512(mapped + i));
+                }
+            }
+            else
+            {
+                commit_scalar::lanes(mask, mapped, values);
+            }
+        }
+    };
+#endif
+
+    // `fn` on the lanes whose bit is set only, one at a time
+    template <typename T, typename Fn>
+    [[gnu::always_inline]] inline void map_set_lanes(bitmap_word mask, T *values, Fn &fn)
+    {
+        for (; mask != 0; mask &= mask - 1)
+        {
+            T &value = values[countr_zero(mask)];
+            value    = static_cast<T>(fn(value));
+        }
+    }
+
+    // every kernel, inlined into one function per instruction set
+    template <typename Commit, typename T, typename Fn>
+    [[gnu::always_inline]] inline void batch_map_words(const bitmap_word *ok_bits, T *values, std::size_t count,
+                                                       Fn &fn)
+    {
+        alignas(64) T mapped[batch_lanes];
+        const std::size_t words = count / batch_lanes;
+        for (std::size_t w = 0; w < words; ++w)
+        {
+            const bitmap_word mask = ok_bits[w];
+            T *chunk               = values + w * batch_lanes;
+            if (mask == ~bitmap_word{0})
+            {
+                map_lanes_in_place(chunk, fn);
+            }
+            else if (mask == 0)
+            {
+                continue;
+            }
+            else if constexpr (batch_blends<T, Fn>)
+            {
+                map_lanes(chunk, mapped, fn);
+                Commit::lanes(mask, mapped, chunk);
+            }
+            else
+            {
+                map_set_lanes(mask, chunk, fn);
+            }
+        }
+
+        // the last, partial word, bits past `count` are 0
+        if (count % batch_lanes != 0)
+        {
+            map_set_lanes(ok_bits[words], values + words * batch_lanes, fn);
+        }
+    }
+
+    template <typename T, typename Fn>
+    void batch_map_scalar(const bitmap_word *ok_bits, T *values, std::size_t count, Fn &fn)
+    {
+        batch_map_words<commit_scalar>(ok_bits, values, count, fn);
+    }
+#if RESULT_BATCH_X86
+    template <typename T, typename Fn>
+    [[gnu::target("sse2")]] void batch_map_sse2(const bitmap_word *ok_bits, T *values, std::size_t count, Fn &fn)
+    {
+        batch_map_words<commit_sse2>(ok_bits, values, count, fn);
+    }
+    template <typename T, typename Fn>
+    [[gnu::target("avx2")]] void batch_map_avx2(const bitmap_word *ok_bits, T *values, std::size_t count, Fn &fn)
+    {
+        batch_map_words<commit_avx2>(ok_bits, values, count, fn);
+    }
+    template <typename T, typename Fn>
+    [[gnu::target("avx512f")]] void batch_map_avx512(const bitmap_word *ok_bits, T *values, std::size_t count,
+                                                     Fn &fn)
+    {
+        batch_map_words<commit_avx512>(ok_bits, values, count, fn);
+    }
+#endif
+
+    template <typename T, typename Fn> constexpr void check_batch_map()
+    {
+        static_assert(std::is_arithmetic_v<T>, "batch_map: `T` must be an arithmetic type");
+        static_assert(std::is_invocable_v<Fn &, T>, "batch_map: `fn` must be callable with a `T`");
+        static_assert(std::is_convertible_v<std::invoke_result_t<Fn &, T>, T>, "batch_map: `fn` must return a `T`");
+    }
+} // namespace result_type::detail
+
+namespace result_type
+{
+    // Marks `fn` as pure for `batch_map`: no side effects, and calling it on
+    // the value of an `Err` slot neither traps nor matters. Lets a floating
+    // point `batch_map` run `fn` on whole words and blend, see above.
+    template <typename Fn> detail::batch_pure_fn<Fn> batch_pure(Fn fn)
+    {
+        return {std::move(fn)};
+    }
+
+    // `fn` on the value of every `Ok` element, with the kernel for `isa` or,
+    // when the CPU does not have it, the best one it has
+    template <typename T, typename E, typename Fn>
+    void batch_map(ResultBuffer<T, E> &results, Fn fn, batch_isa isa = detected_batch_isa())
+    {
+        detail::check_batch_map<T, Fn>();
+        if (isa > detected_batch_isa())
+        {
+            isa = detected_batch_isa();
+        }
+
+        const detail::bitmap_word *ok_bits = results.ok_bits();
+        T *values                          = results.values();
+        const std::size_t count            = results.size();
+        switch (isa)
+        {
+#if RESULT_BATCH_X86
+        case batch_isa::avx512:
+            detail::batch_map_avx512(ok_bits, values, count, fn);
+            return;
+        case batch_isa::avx2:
+            detail::batch_map_avx2(ok_bits, values, count, fn);
+            return;
+        case batch_isa::sse2:
+            detail::batch_map_sse2(ok_bits, values, count, fn);
+            return;
+#endif
+        default:
+            detail::batch_map_scalar(ok_bits, values, count, fn);
+            return;
+        }
+    }
+
+    // `fn` on the value of every `Ok` one of `count` `results`
+    template <typename T, typename E, typename Fn> void batch_map(Result<T, E> *results, std::size_t count, Fn fn)
+    {
+        detail::check_batch_map<T, Fn>();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (results[i].is_ok())
+            {
+                T &value = results[i].unwrap();
+                value    = static_cast<T>(fn(value));
+            }
+        }
+    }
+} // namespace result_type
@@ -0,0 +1,354 @@
+#pragma once
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-observers.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+// Many `Result<T, E>` stored column wise, for batches where most elements are
+// `Ok`:
+//
+// ``` cpp
+// ResultBuffer<Reading, DecodeErr> readings;
+// readings.reserve(frames.size());
+// for (const Frame &frame : frames)
+// {
+//     readings.push_back(decode(frame));
+// }
+//
+// std::size_t failed = readings.count_err();
+// readings.for_each_ok([&](std::size_t index, Reading &reading) { calibrate(reading, index); });
+// ```
+//
+// A `std::vector<Result<T, E>>` pads every element to the larger of `T` and
+// `E` plus a tag. Here one bit per element says which it is, the values are
+// one dense `T` array, indexed like the buffer, and the errors are kept apart
+// with their indices. An `Err` costs its slot in the value array, holding a
+// value initialized `T`, plus its entry in the error store, which `T` has to
+// be default constructible for.
+//
+// `count_ok()` and `count_err()` are constant time, `count_ok(first, last)`
+// counts set bits, and `for_each_ok` walks the set bits word by word. Both
+// compile to `popcnt` and `tzcnt`/`bsf` where the target has them, e.g. with
+// `-mpopcnt` or `-march=native` on x86-64. Single elements go in and out as
+// `Result<T, E>` with `push_back` and `get`.
+namespace result_type::detail
+{
+    using bitmap_word                      = std::uint64_t;
+    constexpr std::size_t bitmap_word_bits = 64;
+
+    inline int popcount(bitmap_word word) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(word));
+#else
+        int count = 0;
+        for (; word != 0; word &= word - 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // index of the lowest set bit, `word` is not 0
+    inline int countr_zero(bitmap_word word) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        int count = 0;
+        for (; (word & 1) == 0; word >>= 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // takes back the last element of `items` unless dismissed, keeps the
+    // columns of a `ResultBuffer` in step when adding to one of them throws
+    template <typename Vector> class pop_back_guard
+    {
+    public:
+        explicit pop_back_guard(Vector &items) noexcept : items_{&items} {}
+        pop_back_guard(const pop_back_guard &)            = delete;
+        pop_back_guard &operator=(const pop_back_guard &) = delete;
+        ~pop_back_guard()
+        {
+            if (items_ != nullptr)
+            {
+                items_->pop_back();
+            }
+        }
+
+        void dismiss() noexcept { items_ = nullptr; }
+
+    private:
+        Vector *items_;
+    };
+} // namespace result_type::detail
+
+namespace result_type
+{
+    template <typename T, typename E> class ResultBuffer
+    {
+        static_assert(!std::is_void_v<T> && !std::is_reference_v<T>, "ResultBuffer: `T` must be an object type");
+        static_assert(std::is_default_constructible_v<T>, "ResultBuffer: `Err` slots hold a value initialized `T`");
+        // the values live in a `std::vector<T>`, which packs `bool` into bits
+        // and has no `T *` or `T &` to hand out
+        static_assert(!std::is_same_v<std::remove_cv_t<T>, bool>,
+                      "ResultBuffer: `bool` values are not supported, store a `std::uint8_t` or an enum instead");
+
+        using word = detail::bitmap_word;
+
+    public:
+        using value_type = T;
+        using error_type = E;
+        using size_type  = std::size_t;
+
+        ResultBuffer() = default;
+
+        template <typename It, typename Sentinel> ResultBuffer(It first, Sentinel last)
+        {
+            if constexpr (std::is_same_v<It, Sentinel> &&
+                          std::is_base_of_v<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<It>::iterator_category>)
+            {
+                reserve(static_cast<size_type>(last - first));
+            }
+            for (; first != last; ++first)
+            {
+                push_back(*first);
+            }
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return values_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+
+        // room for `count` elements, not counting the error store
+        void reserve(size_type count)
+        {
+            ok_bits_.reserve(words_for(count));
+            values_.reserve(count);
+        }
+
+        void clear() noexcept
+        {
+            ok_bits_.clear();
+            values_.clear();
+            err_indices_.clear();
+            errors_.clear();
+        }
+
+        // both leave the buffer as it was when a constructor or an
+        // allocation throws
+        template <typename... Args> void emplace_ok(Args &&...args)
+        {
+            values_.emplace_back(std::forward<Args>(args)...);
+            detail::pop_back_guard<std::vector<T>> undo_value{values_};
+            push_bit(true);
+            undo_value.dismiss();
+        }
+        template <typename... Args> void emplace_err(Args &&...args)
+        {
+            errors_.emplace_back(std::forward<Args>(args)...);
+            detail::pop_back_guard<std::vector<E>> undo_error{errors_};
+            err_indices_.push_back(values_.size());
+            detail::pop_back_guard<std::vector<size_type>> undo_index{err_indices_};
+            values_.emplace_back();
+            detail::pop_back_guard<std::vector<T>> undo_value{values_};
+            push_bit(false);
+            undo_value.dismiss();
+            undo_index.dismiss();
+            undo_error.dismiss();
+        }
+
+        void push_back(const Result<T, E> &result)
+        {
+            if (result.is_ok())
+            {
+                emplace_ok(result.unwrap());
+            }
+            else
+            {
+                emplace_err(result.unwrap_err());
+            }
+        }
+        void push_back(Result<T, E> &&result)
+        {
+            if (result.is_ok())
+            {
+                emplace_ok(std::move(result).unwrap());
+            }
+            else
+            {
+                emplace_err(std::move(result).unwrap_err());
+            }
+        }
+
+        [[nodiscard]] bool is_ok(size_type index) const noexcept
+        {
+            return (ok_bits_[index / detail::bitmap_word_bits] >> (index % detail::bitmap_word_bits) & 1) != 0;
+        }
+        [[nodiscard]] bool is_err(size_type index) const noexcept { return !is_ok(index); }
+
+        [[nodiscard]] size_type count_ok() const noexcept { return size() - count_err(); }
+        [[nodiscard]] size_type count_err() const noexcept { return errors_.size(); }
+
+        // `Ok` elements in [first, last)
+        [[nodiscard]] size_type count_ok(size_type first, size_type last) const noexcept
+        {
+            if (first >= last)
+            {
+                return 0;
+            }
+            const size_type first_word = first / detail::bitmap_word_bits;
+            const size_type last_word  = (last - 1) / detail::bitmap_word_bits;
+            const size_type last_bit   = (last - 1) % detail::bitmap_word_bits;
+            const word head_mask       = ~word{0} << (first % detail::bitmap_word_bits);
+            const word tail_mask       = ~word{0} >> (detail::bitmap_word_bits - 1 - last_bit);
+
+            if (first_word == last_word)
+            {
+                return static_cast<size_type>(detail::popcount(ok_bits_[first_word] & head_mask & tail_mask));
+            }
+            size_type count = static_cast<size_type>(detail::popcount(ok_bits_[first_word] & head_mask));
+            for (size_type i = first_word + 1; i < last_word; ++i)
+            {
+                count += static_cast<size_type>(detail::popcount(ok_bits_[i]));
+            }
+            return count + static_cast<size_type>(detail::popcount(ok_bits_[last_word] & tail_mask));
+        }
+
+        // the value of an `Ok` element, panics on an `Err` one like
+        // `Result::unwrap()`
+        [[nodiscard]] T &unwrap(size_type index)
+        {
+            if (is_err(index))
+            {
+                detail::unwrap_failed<T, E>::unwrap(errors_[error_slot(index)]);
+            }
+            return values_[index];
+        }
+        [[nodiscard]] const T &unwrap(size_type index) const
+        {
+            if (is_err(index))
+            {
+                detail::unwrap_failed<T, E>::unwrap(errors_[error_slot(index)]);
+            }
+            return values_[index];
+        }
+
+        // the error of an `Err` element, a binary search of the error store,
+        // panics on an `Ok` one like `Result::unwrap_err()`
+        [[nodiscard]] E &unwrap_err(size_type index)
+        {
+            if (is_ok(index))
+            {
+                detail::unwrap_failed<T, E>::unwrap_err(values_[index]);
+            }
+            return errors_[error_slot(index)];
+        }
+        [[nodiscard]] const E &unwrap_err(size_type index) const
+        {
+            if (is_ok(index))
+            {
+                detail::unwrap_failed<T, E>::unwrap_err(values_[index]);
+            }
+            return errors_[error_slot(index)];
+        }
+
+        // a copy of one element as a `Result`
+        [[nodiscard]] Result<T, E> get(size_type index) const
+        {
+            if (is_ok(index))
+            {
+                return make_ok<T, E>(values_[index]);
+            }
+            return make_err<T, E>(errors_[error_slot(index)]);
+        }
+
+        // `fn(index, value)` for every `Ok` element, in order
+        template <typename Fn> void for_each_ok(Fn &&fn) { for_each_ok_impl(*this, fn); }
+        template <typename Fn> void for_each_ok(Fn &&fn) const { for_each_ok_impl(*this, fn); }
+
+        // `fn(index, error)` for every `Err` element, in order
+        template <typename Fn> void for_each_err(Fn &&fn) { for_each_err_impl(*this, fn); }
+        template <typename Fn> void for_each_err(Fn &&fn) const { for_each_err_impl(*this, fn); }
+
+        // the columns: one `Ok` bit per element, lowest bit first, and every
+        // element's `T`, only meaningful where the bit is set
+        [[nodiscard]] const word *ok_bits() const noexcept { return ok_bits_.data(); }
+        [[nodiscard]] size_type ok_bits_size() const noexcept { return ok_bits_.size(); }
+        [[nodiscard]] T *values() noexcept { return values_.data(); }
+        [[nodiscard]] const T *values() const noexcept { return values_.data(); }
+
+    private:
+        static constexpr size_type words_for(size_type count) noexcept
+        {
+            return (count + detail::bitmap_word_bits - 1) / detail::bitmap_word_bits;
+        }
+
+        // the bit of the element just added to `values_`, in a fresh bitmap
+        // word for every 64th element, unused bits stay 0
+        void push_bit(bool ok)
+        {
+            const size_type index = values_.size() - 1;
+            if (index % detail::bitmap_word_bits == 0)
+            {
+                ok_bits_.push_back(0);
+            }
+            ok_bits_.back() |= word{ok} << (index % detail::bitmap_word_bits);
+        }
+
+        size_type error_slot(size_type index) const noexcept
+        {
+            return static_cast<size_type>(std::lower_bound(err_indices_.begin(), err_indices_.end(), index) -
+                                          err_indices_.begin());
+        }
+
+        template <typename Self, typename Fn> static void for_each_ok_impl(Self &self, Fn &fn)
+        {
+            const size_type words = self.ok_bits_.size();
+            for (size_type w = 0; w < words; ++w)
+            {
+                for (word bits = self.ok_bits_[w]; bits != 0; bits &= bits - 1)
+                {
+                    const size_type index =
+                        w * detail::bitmap_word_bits + static_cast<size_type>(detail::countr_zero(bits));
+                    fn(index, self.values_[index]);
+                }
+            }
+        }
+
+        template <typename Self, typename Fn> static void for_each_err_impl(Self &self, Fn &fn)
+        {
+            for (size_type i = 0; i < self.errors_.size(); ++i)
+            {
+                fn(self.err_indices_[i], self.errors_[i]);
+            }
+        }
+
+        std::vector<word> ok_bits_;
+        std::vector<T> values_;
+        // ascending, `errors_[i]` belongs to element `err_indices_[i]`
+        std::vector<size_type> err_indices_;
+        std::vector<E> errors_;
+    };
+} // namespace result_type
@@ -0,0 +1,206 @@
+#pragma once
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-monadics.hpp"
+#include "result-type-observers.hpp"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A range of `Result<T, E>` turned into one `Result`, stopping at the first
+// `Err`:
+//
+// ``` cpp
+// std::vector<Result<Record, ParseErr>> parsed = parse_all(lines);
+//
+// Result<std::vector<Record>, ParseErr> records = try_collect(std::move(parsed));
+// auto names = collect<std::set<std::string>>(name_results);
+//
+// std::array<Record, 16> buffer;
+// auto end = collect_into(parsed, buffer.begin()); // Result<Record *, ParseErr>
+// ```
+//
+// `try_collect` collects into a `std::vector<T>`, `collect<Container>` into
+// any container with `emplace_back` or `insert(end, value)`. When the number
+// of elements is known up front, from `size()` or random access iterators,
+// containers with `reserve` reserve it once. `collect_into` allocates
+// nothing, it writes to an output iterator and returns it past the last
+// value; `out` must have room for every element. Like any `Result` value the
+// iterator has to be debuggable: pointers and the standard inserters are.
+//
+// The elements of an rvalue range, and those of move iterators, are moved
+// out of it. Anything else is copied.
+namespace result_type::detail
+{
+    template <typename Range> using range_iterator_t = decltype(std::begin(std::declval<Range &>()));
+
+    template <typename It> using iter_result_t = helper::remove_cvref_t<decltype(*std::declval<It &>())>;
+    template <typename It> using iter_value_t  = typename iter_result_t<It>::value_type;
+    template <typename It> using iter_error_t  = typename iter_result_t<It>::error_type;
+
+    template <typename C, typename = void> constexpr bool has_reserve = false;
+    template <typename C>
+    constexpr bool has_reserve<C, std::void_t<decltype(std::declval<C &>().reserve(std::size_t{}))>> = true;
+
+    template <typename C, typename V, typename = void> constexpr bool has_emplace_back = false;
+    template <typename C, typename V>
+    constexpr bool has_emplace_back<C, V, std::void_t<decltype(std::declval<C &>().emplace_back(std::declval<V>()))>> =
+        true;
+
+    template <typename Range, typename = void> constexpr bool has_size = false;
+    template <typename Range>
+    constexpr bool has_size<Range, std::void_t<decltype(std::size(std::declval<Range &>()))>> = true;
+
+    template <typename It, typename Sentinel>
+    constexpr bool random_access_pair =
+        std::is_same_v<It, Sentinel> &&
+        std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+    // Hands the `Ok` value of every element of [first, last) to `put(out,
+    // value)` up to the first `Err`, which becomes the result. `Move` moves
+    // from elements that are lvalues.
+    template <bool Move, typename Out, typename It, typename Sentinel, typename Put>
+    constexpr Result<Out, iter_error_t<It>> collect_values(It first, Sentinel last, Out out, Put put)
+    {
+        using R = iter_result_t<It>;
+        static_assert(helper::is_result_type<R>, "collect: the elements must be `Result`s");
+        static_assert(!std::is_void_v<typename R::value_type>, "collect: `Result<void, E>` has no values to collect");
+
+        for (; first != last; ++first)
+        {
+            auto &&result = *first;
+            using Element = std::conditional_t<Move, std::remove_reference_t<decltype(result)> &&, decltype(result) &&>;
+
+            if (result.is_err())
+            {
+                return make_err<Out, typename R::error_type>(static_cast<Element>(result).unwrap_err());
+            }
+            put(out, static_cast<Element>(result).unwrap());
+        }
+        return make_ok<Out, typename R::error_type>(std::move(out));
+    }
+
+    template <typename Container, bool Move, typename It, typename Sentinel>
+    constexpr Result<Container, iter_error_t<It>> collect_container(It first, Sentinel last, std::size_t size_hint)
+    {
+        Container container;
+        if constexpr (has_reserve<Container>)
+        {
+            if (size_hint != 0)
+            {
+                container.reserve(size_hint);
+            }
+        }
+        return collect_values<Move>(std::move(first), std::move(last), std::move(container),
+                                    [](Container &into, auto &&value)
+                                    {
+                                        using V = decltype(value);
+                                        if constexpr (has_emplace_back<Container, V>)
+                                        {
+                                            into.emplace_back(std::forward<V>(value));
+                                        }
+                                        else
+                                        {
+                                            into.insert(into.end(), std::forward<V>(value));
+                                        }
+                                    });
+    }
+
+    template <typename It, typename Sentinel> constexpr std::size_t distance_hint(const It &first, const Sentinel &last)
+    {
+        if constexpr (random_access_pair<It, Sentinel>)
+        {
+            return static_cast<std::size_t>(std::distance(first, last));
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    template <typename Range> constexpr std::size_t size_hint(Range &range)
+    {
+        if constexpr (has_size<Range>)
+        {
+            return static_cast<std::size_t>(std::size(range));
+        }
+        else
+        {
+            return distance_hint(std::begin(range), std::end(range));
+        }
+    }
+} // namespace result_type::detail
+
+namespace result_type
+{
+    // `collect_into` returns its output iterator, and the inserters have
+    // nothing to show but the address of their container
+    template <typename C> struct result_debug<std::back_insert_iterator<C>> : debug_opaque<std::back_insert_iterator<C>>
+    {
+    };
+    template <typename C>
+    struct result_debug<std::front_insert_iterator<C>> : debug_opaque<std::front_insert_iterator<C>>
+    {
+    };
+    template <typename C> struct result_debug<std::insert_iterator<C>> : debug_opaque<std::insert_iterator<C>>
+    {
+    };
+
+    // `Ok` with every value of `range` in a `Container`, or its first `Err`
+    template <typename Container, typename Range>
+    constexpr auto collect(Range &&range) -> Result<Container, detail::iter_error_t<detail::range_iterator_t<Range>>>
+    {
+        constexpr bool move = !std::is_lvalue_reference_v<Range>;
+        return detail::collect_container<Container, move>(std::begin(range), std::end(range),
+                                                          detail::size_hint(range));
+    }
+    template <typename Container, typename It, typename Sentinel>
+    constexpr auto collect(It first, Sentinel last) -> Result<Container, detail::iter_error_t<It>>
+    {
+        const std::size_t size_hint = detail::distance_hint(first, last);
+        return detail::collect_container<Container, false>(std::move(first), std::move(last), size_hint);
+    }
+
+    // `collect` into a `std::vector`
+    template <typename Range>
+    constexpr auto try_collect(Range &&range)
+        -> Result<std::vector<detail::iter_value_t<detail::range_iterator_t<Range>>>,
+                  detail::iter_error_t<detail::range_iterator_t<Range>>>
+    {
+        using Vector = std::vector<detail::iter_value_t<detail::range_iterator_t<Range>>>;
+        return collect<Vector>(std::forward<Range>(range));
+    }
+    template <typename It, typename Sentinel>
+    constexpr auto try_collect(It first, Sentinel last)
+        -> Result<std::vector<detail::iter_value_t<It>>, detail::iter_error_t<It>>
+    {
+        return collect<std::vector<detail::iter_value_t<It>>>(std::move(first), std::move(last));
+    }
+
+    // writes every value of `range` to `out`, `Ok` with `out` past the last
+    // one, or the first `Err`
+    template <typename Range, typename OutputIt>
+    constexpr auto collect_into(Range &&range, OutputIt out)
+        -> Result<OutputIt, detail::iter_error_t<detail::range_iterator_t<Range>>>
+    {
+        constexpr bool move = !std::is_lvalue_reference_v<Range>;
+        return detail::collect_values<move>(std::begin(range), std::end(range), std::move(out),
+                                            [](OutputIt &into, auto &&value)
+                                            {
+                                                *into = std::forward<decltype(value)>(value);
+                                                ++into;
+                                            });
+    }
+    template <typename It, typename Sentinel, typename OutputIt>
+    constexpr auto collect_into(It first, Sentinel last, OutputIt out) -> Result<OutputIt, detail::iter_error_t<It>>
+    {
+        return detail::collect_values<false>(std::move(first), std::move(last), std::move(out),
+                                             [](OutputIt &into, auto &&value)
+                                             {
+                                                 *into = std::forward<decltype(value)>(value);
+                                                 ++into;
+                                             });
+    }
+} // namespace result_type
@@ -0,0 +1,183 @@
+#pragma once
+#include "result.hpp"
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#    error "result-coroutine.hpp needs C++20 coroutines"
+#endif
+
+// the return object has to be converted to the `Result` after the body ran,
+// see below; MSVC converts it as soon as `get_return_object` returns
+#if defined(_MSC_VER) && !defined(__clang__)
+#    error "result-coroutine.hpp needs the return object converted after the coroutine body ran, MSVC does it before"
+#endif
+
+#include <coroutine>
+#include <cstdlib>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Lets a function returning `Result<T, E>` be written as a coroutine, a
+// portable alternative to `TRY_OK`:
+//
+// ``` cpp
+// auto load(path p) -> Result<Config, Error>
+// {
+//     auto text   = co_await read_file(p);   // returns early with its `Err`
+//     auto config = co_await parse(text);
+//     co_return config;                     // or `Ok(config)` / `Err(...)`
+// }
+// ```
+//
+// `co_await` only accepts a `Result` whose error converts to `E`. The body
+// must end in a `co_return`, for `Result<void, E>` that is `co_return Ok();`.
+//
+// The coroutine runs to completion inside the call. The frame is freed by the
+// caller-side conversion of the return object right after the body finished,
+// the shape compilers need to elide the frame allocation (HALO), e.g. clang
+// once the call is inlined. GCC always allocates the frame.
+//
+// Needs a compiler that converts the return object after the body ran, which
+// the standard leaves open (CWG2563). GCC does, and so does clang for a return
+// object of another type than the function returns, which `result_return`
+// is. MSVC converts it right away and is rejected above; any other compiler
+// doing so panics on the first call instead of reading a `Result` that does
+// not exist yet.
+namespace result_type::detail
+{
+    template <typename T, typename E> class result_promise;
+
+    // returned by `get_return_object`, turns into the `Result` the body produced
+    template <typename T, typename E> class [[nodiscard]] result_return
+    {
+    public:
+        using handle_type = std::coroutine_handle<result_promise<T, E>>;
+
+        explicit result_return(handle_type handle) noexcept : handle_{handle} {}
+        result_return(result_return &&other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+        result_return &operator=(result_return &&) = delete;
+        // only skipped when an exception leaves the body, the coroutine
+        // machinery frees the frame on that path itself
+        ~result_return() = default;
+
+        operator Result<T, E>()
+        {
+            if (!handle_.promise().has_result())
+            {
+                panic("result-coroutine.hpp: the coroutine's return object was converted before the body ran");
+            }
+            // frees the frame once the result has been moved out
+            struct frame_guard
+            {
+                handle_type handle;
+                ~frame_guard() { handle.destroy(); }
+            } guard{std::exchange(handle_, nullptr)};
+
+            return std::move(guard.handle.promise()).take();
+        }
+
+    private:
+        handle_type handle_;
+    };
+
+    // `co_await` on a `Result`, `R` is the (reference to the) awaited `Result`
+    template <typename R> class result_awaiter
+    {
+        using awaited_type = helper::remove_cvref_t<R>;
+        using value_type   = typename awaited_type::value_type;
+
+    public:
+        explicit result_awaiter(R &&result) noexcept : result_{std::forward<R>(result)} {}
+
+        bool await_ready() const noexcept { return result_.is_ok(); }
+
+        // stores the error and stays suspended, the caller destroys the frame
+        template <typename Promise> void await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            handle.promise().return_err(std::forward<R>(result_).unwrap_err());
+        }
+
+        // a value is moved out of an awaited temporary rather than referenced
+        auto await_resume() -> std::conditional_t<std::is_lvalue_reference_v<R> || std::is_void_v<value_type>,
+                                                  decltype(std::declval<R &&>().unwrap()), value_type>
+        {
+            return std::forward<R>(result_).unwrap();
+        }
+
+    private:
+        R &&result_;
+    };
+
+    template <typename T, typename E> class result_promise_base
+    {
+    public:
+        result_return<T, E> get_return_object() noexcept
+        {
+            return result_return<T, E>{std::coroutine_handle<result_promise<T, E>>::from_promise(
+                static_cast<result_promise<T, E> &>(*this))};
+        }
+
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        // keeps the frame alive until the caller moved the result out
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        // propagates out of the call like from any other function
+        void unhandled_exception()
+        {
+#if defined(__cpp_exceptions)
+            throw;
+#else
+            std::abort();
+#endif
+        }
+
+        template <typename R, typename = std::enable_if_t<helper::is_result_type<helper::remove_cvref_t<R>>>>
+        result_awaiter<R> await_transform(R &&result) noexcept
+        {
+            static_assert(std::is_constructible_v<E, decltype(std::declval<R &&>().unwrap_err())>,
+                          "the awaited `Result`'s error type does not convert to this coroutine's error type");
+            return result_awaiter<R>{std::forward<R>(result)};
+        }
+
+        template <typename G> void return_err(G &&err) { result_.emplace(in_place_err, std::forward<G>(err)); }
+
+        // false until a `co_return` or a failed `co_await`
+        [[nodiscard]] bool has_result() const noexcept { return result_.has_value(); }
+
+        Result<T, E> take() && noexcept { return std::move(*result_); }
+
+    protected:
+        std::optional<Result<T, E>> result_;
+    };
+
+    template <typename T, typename E> class result_promise : public result_promise_base<T, E>
+    {
+    public:
+        // anything a `Result<T, E>` converts from, `Ok(...)` / `Err(...)` among
+        // others, or a plain `T`
+        template <typename U = T> void return_value(U &&value)
+        {
+            if constexpr (std::is_constructible_v<Result<T, E>, U &&>)
+            {
+                this->result_.emplace(std::forward<U>(value));
+            }
+            else
+            {
+                this->result_.emplace(in_place_ok, std::forward<U>(value));
+            }
+        }
+    };
+
+    template <typename E> class result_promise<void, E> : public result_promise_base<void, E>
+    {
+    public:
+        // a promise cannot have both `return_value` and `return_void`, so
+        // success is spelled `co_return Ok();`
+        template <typename U> void return_value(U &&value) { this->result_.emplace(std::forward<U>(value)); }
+    };
+} // namespace result_type::detail
+
+template <typename T, typename E, typename... Args> struct std::coroutine_traits<result_type::Result<T, E>, Args...>
+{
+    using promise_type = result_type::detail::result_promise<T, E>;
+};
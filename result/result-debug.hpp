@@ -0,0 +1,424 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(RESULT_DEBUG_USE_STD_FORMAT)
+#    include <format>
+#endif
+#if defined(RESULT_DEBUG_USE_FMT)
+#    include <fmt/format.h>
+#endif
+
+namespace result_type
+{
+    // Fixed size character buffer the debug representation of a value is
+    // written into. Output that does not fit is dropped and remembered in
+    // `truncated()`.
+    class debug_sink
+    {
+    public:
+        constexpr debug_sink(char *buffer, std::size_t size) noexcept
+            : begin_{buffer}, cursor_{buffer}, end_{buffer + size}
+        {
+        }
+
+        constexpr void put(char ch) noexcept
+        {
+            if (cursor_ == end_)
+            {
+                truncated_ = true;
+                return;
+            }
+            *cursor_++ = ch;
+        }
+
+        constexpr void write(std::string_view text) noexcept
+        {
+            for (char ch : text)
+            {
+                put(ch);
+            }
+        }
+
+        // unused space, for writers like `std::to_chars` that fill a range
+        // and report how far they got, see `commit`
+        [[nodiscard]] constexpr char *first() const noexcept { return cursor_; }
+        [[nodiscard]] constexpr char *last() const noexcept { return end_; }
+
+        constexpr void commit(char *new_cursor) noexcept { cursor_ = new_cursor; }
+        constexpr void mark_truncated() noexcept { truncated_ = true; }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept
+        {
+            return {begin_, static_cast<std::size_t>(cursor_ - begin_)};
+        }
+        [[nodiscard]] constexpr bool truncated() const noexcept { return truncated_; }
+
+    private:
+        char *begin_;
+        char *cursor_;
+        char *end_;
+        bool truncated_ = false;
+    };
+
+    namespace detail
+    {
+        template <typename T, typename = void> struct default_debug;
+    }
+
+    // Customization point deciding how a value shows up in panic messages,
+    // e.g. the `Err` payload of a failed `unwrap()`. Every `T` and `E` of a
+    // `Result` needs one.
+    //
+    // Without a specialization the first match below is used:
+    //
+    //   * string-like types, `bool`, characters and arithmetic types
+    //   * pointers, printed as their address
+    //   * a `to_chars(char *first, char *last, const T &)` found by ADL,
+    //     returning something with `ptr` and `ec` like `std::to_chars`
+    //   * `std::formatter<T>` with `RESULT_DEBUG_USE_STD_FORMAT` defined
+    //   * `fmt::formatter<T>` with `RESULT_DEBUG_USE_FMT` defined
+    //   * a non-member `operator<<(std::ostream &, const T &)`, `<ostream>`
+    //     has to be included wherever such a value can panic
+    //   * enumerations, printed as their underlying value
+    //   * anything else with `begin()` and `end()` members iterating over
+    //     debuggable values, printed as `[a, b, c]`
+    //
+    // Types with none of these either specialize the trait:
+    //
+    // ``` cpp
+    // template <> struct result_type::result_debug<Handle>
+    // {
+    //     static void format(result_type::debug_sink &sink, const Handle &handle) { sink.write(handle.name()); }
+    // };
+    // ```
+    //
+    // or opt in to only printing their type and address:
+    //
+    // ``` cpp
+    // template <> struct result_type::result_debug<Handle> : result_type::debug_opaque<Handle>
+    // {
+    // };
+    // ```
+    template <typename T, typename = void> struct result_debug : detail::default_debug<T>
+    {
+    };
+
+    namespace detail
+    {
+        // best effort `T` spelling, taken from the compiler's function signature
+        template <typename T> constexpr std::string_view type_name() noexcept
+        {
+#if defined(__clang__) || defined(__GNUC__)
+            constexpr std::string_view signature = __PRETTY_FUNCTION__;
+            constexpr std::string_view marker    = "T = ";
+            const std::size_t start              = signature.find(marker);
+            if (start == std::string_view::npos)
+            {
+                return "?";
+            }
+            std::string_view name = signature.substr(start + marker.size());
+            return name.substr(0, name.find_first_of(";]"));
+#else
+            return "?";
+#endif
+        }
+
+        inline void write_address(debug_sink &sink, const void *ptr) noexcept
+        {
+            char digits[2 * sizeof(void *)];
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), reinterpret_cast<std::uintptr_t>(ptr), 16);
+            (void)ec; // always fits
+            sink.write("0x");
+            sink.write({digits, static_cast<std::size_t>(end - digits)});
+        }
+
+        template <typename Number> void write_number(debug_sink &sink, Number value) noexcept
+        {
+            // big enough for the shortest round trip form of any floating point type
+            char digits[128];
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+            if (ec != std::errc{})
+            {
+                sink.write("?");
+                return;
+            }
+            sink.write({digits, static_cast<std::size_t>(end - digits)});
+        }
+
+        namespace adl
+        {
+            // hides every `to_chars` but the ones found by ADL
+            void to_chars() = delete;
+
+            template <typename T, typename = void> constexpr bool has_to_chars = false;
+            template <typename T>
+            constexpr bool has_to_chars<T, std::void_t<decltype(to_chars(std::declval<char *>(),
+                                                                         std::declval<char *>(),
+                                                                         std::declval<const T &>())
+                                                                    .ptr)>> = true;
+
+            template <typename T> void write_to_chars(debug_sink &sink, const T &value)
+            {
+                auto [end, ec] = to_chars(sink.first(), sink.last(), value);
+                if (ec != std::errc{})
+                {
+                    sink.commit(sink.last());
+                    sink.mark_truncated();
+                    return;
+                }
+                sink.commit(end);
+            }
+        } // namespace adl
+
+        // whether `stream << value` compiles for a `const Probe &` value;
+        // `Char` only defers naming `std::basic_ostream` until a value is
+        // actually printed, so `<iosfwd>` is enough up to that point
+        template <typename Probe, typename Char, typename = void> struct streams : std::false_type
+        {
+        };
+        template <typename Probe, typename Char>
+        struct streams<Probe, Char,
+                       std::void_t<decltype(std::declval<std::basic_ostream<Char> &>() << std::declval<const Probe &>())>>
+            : std::true_type
+        {
+        };
+
+        // Converts to `T` and nothing else, so only an `operator<<` taking
+        // `T` itself accepts it, not one of the overloads `<ostream>` brings
+        // along. It cannot deduce a template's parameters from `T` though.
+        template <typename T> struct exactly
+        {
+            template <typename U, typename = std::enable_if_t<std::is_same_v<U, T>>> operator U() const;
+        };
+
+        // `T` reaches `<ostream>`'s own overloads for built in types, `int`
+        // covers every arithmetic type and `const volatile void *` every
+        // object pointer, `const char *` included
+        template <typename T>
+        constexpr bool converts_to_streamed_builtin =
+            std::is_convertible_v<const T &, int> || std::is_convertible_v<const T &, const volatile void *>;
+
+        // The answer must not depend on whether `<ostream>` was included.
+        // Enums, and classes that convert to a built in type, would find its
+        // overloads through the conversion, so they are probed with
+        // `exactly<T>`; any other class with `T` itself, which lets an
+        // inserter template like `std::complex`'s deduce. Built in types
+        // have their own branch and are never probed.
+        template <typename T, typename Char = char, typename = void> constexpr bool has_ostream = false;
+        template <typename T, typename Char>
+        constexpr bool has_ostream<T, Char, std::enable_if_t<std::is_enum_v<T>>> = streams<exactly<T>, Char>::value;
+        template <typename T, typename Char>
+        constexpr bool has_ostream<T, Char, std::enable_if_t<std::is_class_v<T> || std::is_union_v<T>>> =
+            std::conditional_t<converts_to_streamed_builtin<T>, streams<exactly<T>, Char>, streams<T, Char>>::value;
+
+        // `std::basic_streambuf` over a `debug_sink`
+        template <typename Char> class sink_streambuf : public std::basic_streambuf<Char>
+        {
+        public:
+            using int_type    = typename std::basic_streambuf<Char>::int_type;
+            using traits_type = typename std::basic_streambuf<Char>::traits_type;
+
+            explicit sink_streambuf(debug_sink &sink) : sink_{sink} {}
+
+        protected:
+            int_type overflow(int_type ch) override
+            {
+                if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                {
+                    sink_.put(traits_type::to_char_type(ch));
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            std::streamsize xsputn(const Char *text, std::streamsize count) override
+            {
+                sink_.write({text, static_cast<std::size_t>(count)});
+                return count;
+            }
+
+        private:
+            debug_sink &sink_;
+        };
+
+        template <typename Char, typename T> void write_ostream(debug_sink &sink, const T &value)
+        {
+            sink_streambuf<Char> buf{sink};
+            std::basic_ostream<Char> oss{&buf};
+            oss << value;
+        }
+
+#if defined(RESULT_DEBUG_USE_STD_FORMAT)
+        template <typename T>
+        constexpr bool has_std_formatter = std::is_default_constructible_v<std::formatter<T, char>>;
+#else
+        template <typename T> constexpr bool has_std_formatter = false;
+#endif
+
+#if defined(RESULT_DEBUG_USE_FMT)
+        template <typename T> constexpr bool has_fmt_formatter = fmt::is_formattable<T>::value;
+#else
+        template <typename T> constexpr bool has_fmt_formatter = false;
+#endif
+
+        template <typename T> void write_formatted(debug_sink &sink, const T &value)
+        {
+            const auto capacity = static_cast<std::size_t>(sink.last() - sink.first());
+#if defined(RESULT_DEBUG_USE_STD_FORMAT)
+            if constexpr (has_std_formatter<T>)
+            {
+                auto [end, size] = std::format_to_n(sink.first(), capacity, "{}", value);
+                sink.commit(end);
+                if (static_cast<std::size_t>(size) > capacity)
+                {
+                    sink.mark_truncated();
+                }
+                return;
+            }
+#endif
+#if defined(RESULT_DEBUG_USE_FMT)
+            if constexpr (!has_std_formatter<T> && has_fmt_formatter<T>)
+            {
+                auto [end, size] = fmt::format_to_n(sink.first(), capacity, "{}", value);
+                sink.commit(end);
+                if (static_cast<std::size_t>(size) > capacity)
+                {
+                    sink.mark_truncated();
+                }
+            }
+#endif
+            (void)sink, (void)value, (void)capacity;
+        }
+
+        template <typename T>
+        constexpr bool has_default_debug = std::is_convertible_v<const T &, std::string_view> ||
+                                           std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> ||
+                                           std::is_null_pointer_v<T> || adl::has_to_chars<T> ||
+                                           has_std_formatter<T> || has_fmt_formatter<T> || has_ostream<T>;
+
+        template <typename T, typename> struct default_debug
+        {
+            // no `format`, `T` is not debuggable
+        };
+
+        template <typename T> struct default_debug<T, std::enable_if_t<has_default_debug<T>>>
+        {
+            static void format(debug_sink &sink, const T &value)
+            {
+                if constexpr (std::is_convertible_v<const T &, std::string_view>)
+                {
+                    sink.write(static_cast<std::string_view>(value));
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    sink.write(value ? "true" : "false");
+                }
+                else if constexpr (std::is_same_v<T, char>)
+                {
+                    sink.put(value);
+                }
+                else if constexpr (std::is_arithmetic_v<T>)
+                {
+                    write_number(sink, value);
+                }
+                else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+                {
+                    write_address(sink, value);
+                }
+                else if constexpr (adl::has_to_chars<T>)
+                {
+                    adl::write_to_chars(sink, value);
+                }
+                else if constexpr (has_std_formatter<T> || has_fmt_formatter<T>)
+                {
+                    write_formatted(sink, value);
+                }
+                else if constexpr (has_ostream<T>)
+                {
+                    write_ostream<char>(sink, value);
+                }
+                else
+                {
+                    // an enum nothing else knows how to print
+                    write_number(sink, static_cast<std::underlying_type_t<T>>(value));
+                }
+            }
+        };
+    } // namespace detail
+
+    // Explicit fallback for types with nothing better to show, prints
+    // `<type-name @ address>`.
+    template <typename T> struct debug_opaque
+    {
+        static void format(debug_sink &sink, const T &value) noexcept
+        {
+            sink.put('<');
+            sink.write(detail::type_name<T>());
+            sink.write(" @ ");
+            detail::write_address(sink, static_cast<const void *>(std::addressof(value)));
+            sink.put('>');
+        }
+    };
+
+    namespace detail
+    {
+        template <typename T, typename = void> constexpr bool has_debug_format = false;
+        template <typename T>
+        constexpr bool has_debug_format<T, std::void_t<decltype(result_debug<T>::format(
+                                               std::declval<debug_sink &>(), std::declval<const T &>()))>> = true;
+    } // namespace detail
+
+    template <typename T> constexpr bool is_debuggable_v = detail::has_debug_format<std::remove_cv_t<T>>;
+
+    namespace detail
+    {
+        template <typename T>
+        using range_element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<const T &>().begin())>>;
+
+        template <typename T, typename = void> struct is_debug_range : std::false_type
+        {
+        };
+        template <typename T>
+        struct is_debug_range<T, std::void_t<range_element_t<T>, decltype(std::declval<const T &>().end())>>
+            : std::bool_constant<is_debuggable_v<range_element_t<T>>>
+        {
+        };
+
+        // `conjunction` keeps the element type of anything printable some
+        // other way out of it, `std::filesystem::path` iterates over paths
+        template <typename T>
+        struct default_debug<T, std::enable_if_t<std::conjunction_v<std::bool_constant<!has_default_debug<T>>,
+                                                                    is_debug_range<T>>>>
+        {
+            static void format(debug_sink &sink, const T &values)
+            {
+                sink.put('[');
+                bool first = true;
+                for (const auto &value : values)
+                {
+                    if (!first)
+                    {
+                        sink.write(", ");
+                    }
+                    first = false;
+                    result_debug<range_element_t<T>>::format(sink, value);
+                }
+                sink.put(']');
+            }
+        };
+    } // namespace detail
+
+    // appends the debug representation of `value` to `sink`
+    template <typename T> void debug_write(debug_sink &sink, const T &value)
+    {
+        using type = std::remove_cv_t<T>;
+        static_assert(is_debuggable_v<type>, "no `result_type::result_debug` for this type, see result-debug.hpp");
+        result_debug<type>::format(sink, value);
+    }
+} // namespace result_type
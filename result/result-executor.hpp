@@ -0,0 +1,720 @@
+#pragma once
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-observers.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A pool of worker threads for fallible tasks, each returning a `Result`:
+//
+// ``` cpp
+// Executor executor;
+// std::vector<Task<Page, FetchErr>> pages;
+// for (const Url &url : urls)
+// {
+//     pages.push_back(executor.spawn([&url] { return fetch(url); }));
+// }
+// Result<std::vector<Page>, FetchErr> fetched = join_all(pages);
+// ```
+//
+// Every worker owns a Chase-Lev deque. Tasks spawned from a worker, i.e.
+// from inside another task, go to the bottom of its deque and are taken
+// from there last in first out. Idle workers steal from the top of the
+// others' deques. Pushing, popping and stealing are lock free; only tasks
+// spawned from outside the pool go through a queue under a mutex, and a
+// worker that found nothing to run sleeps on a condition variable after
+// yielding for a while.
+//
+// `Task::join()` on a worker runs other tasks until the one joined has
+// finished, so tasks can spawn and join their own subtasks without tying up
+// a worker. A thread outside the pool waits in it, sleeping after a while.
+// `fn` runs on whichever thread picks it up and has to report failure as an
+// `Err`: an exception escaping it terminates, as with `std::thread`.
+//
+// Each spawn allocates one block holding `fn` and its `Result`, shared by
+// the `Task` handle and the executor. Dropping a `Task` without joining it
+// detaches the task, which still runs. The destructor of the `Executor` runs
+// every task spawned before it, then stops the workers.
+namespace result_type
+{
+    class Executor;
+    template <typename T, typename E> class Task;
+} // namespace result_type
+
+namespace result_type::detail
+{
+    // a spawned function, referenced by its `Task` and by the executor until
+    // it has run
+    class task_base
+    {
+    public:
+        task_base()                             = default;
+        task_base(const task_base &)            = delete;
+        task_base &operator=(const task_base &) = delete;
+
+        virtual void run() noexcept = 0;
+
+        [[nodiscard]] bool done() const noexcept { return done_.load(std::memory_order_acquire); }
+
+        void release() noexcept
+        {
+            if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
+        }
+
+    protected:
+        virtual ~task_base() = default;
+
+        void finish() noexcept { done_.store(true, std::memory_order_release); }
+
+    private:
+        std::atomic<int> refs_{2};
+        std::atomic<bool> done_{false};
+    };
+
+    template <typename T, typename E> class task_result : public task_base
+    {
+    public:
+        // once `done()`
+        Result<T, E> take() { return std::move(*result_); }
+
+    protected:
+        std::optional<Result<T, E>> result_;
+    };
+
+    template <typename Fn, typename T, typename E> class task_state final : public task_result<T, E>
+    {
+    public:
+        explicit task_state(Fn &&fn) : fn_{std::move(fn)} {}
+
+        void run() noexcept override
+        {
+            this->result_.emplace(std::invoke(*fn_));
+            // whatever `fn` captured goes before the `Task` sees the result
+            fn_.reset();
+            this->finish();
+        }
+
+    private:
+        std::optional<Fn> fn_;
+    };
+
+    // The deque of "Correct and Efficient Work-Stealing for Weak Memory
+    // Models" (Lê et al., 2013). The owner pushes and pops at the bottom,
+    // any thread steals from the top, the ring doubles when full. Old rings
+    // stay allocated until the deque goes, a thief may still read them.
+    class work_deque
+    {
+    public:
+        work_deque() { ring_.store(grow_into(initial_capacity), std::memory_order_relaxed); }
+
+        // owner only
+        void push(task_base *task)
+        {
+            const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const std::int64_t top    = top_.load(std::memory_order_acquire);
+            ring *slots               = ring_.load(std::memory_order_relaxed);
+            if (bottom - top > slots->mask)
+            {
+                ring *larger = grow_into(2 * (slots->mask + 1));
+                for (std::int64_t i = top; i < bottom; ++i)
+                {
+                    larger->put(i, slots->get(i));
+                }
+                slots = larger;
+                ring_.store(slots, std::memory_order_release);
+            }
+            slots->put(bottom, task);
+            bottom_.store(bottom + 1, std::memory_order_release);
+        }
+
+        // owner only, the task pushed last or nullptr
+        task_base *pop()
+        {
+            const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            ring *slots               = ring_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t top = top_.load(std::memory_order_relaxed);
+            if (top > bottom)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            task_base *task = slots->get(bottom);
+            if (top == bottom)
+            {
+                // the last one, which a thief may be taking as well
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                {
+                    task = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        // any thread, the oldest task or nullptr when empty or when another
+        // thread took it first
+        task_base *steal()
+        {
+            std::int64_t top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+            task_base *task = ring_.load(std::memory_order_acquire)->get(top);
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return task;
+        }
+
+        // any thread, may miss a task pushed concurrently; see
+        // `Executor::work` for how a sleeping worker still learns of it
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::int64_t initial_capacity = 256;
+
+        struct ring
+        {
+            explicit ring(std::int64_t capacity)
+                : mask{capacity - 1}, slots{new std::atomic<task_base *>[static_cast<std::size_t>(capacity)]}
+            {
+            }
+
+            task_base *get(std::int64_t index) const noexcept
+            {
+                return slots[static_cast<std::size_t>(index & mask)].load(std::memory_order_relaxed);
+            }
+            void put(std::int64_t index, task_base *task) noexcept
+            {
+                slots[static_cast<std::size_t>(index & mask)].store(task, std::memory_order_relaxed);
+            }
+
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<task_base *>[]> slots;
+        };
+
+        ring *grow_into(std::int64_t capacity)
+        {
+            rings_.push_back(std::make_unique<ring>(capacity));
+            return rings_.back().get();
+        }
+
+        // on separate cache lines, the owner writes one and thieves the other
+        alignas(64) std::atomic<std::int64_t> top_{0};
+        alignas(64) std::atomic<std::int64_t> bottom_{0};
+        std::atomic<ring *> ring_{nullptr};
+        // owner only
+        std::vector<std::unique_ptr<ring>> rings_;
+    };
+
+    // which worker of which executor the current thread is, if any
+    struct worker_slot
+    {
+        const Executor *executor = nullptr;
+        std::size_t index        = 0;
+    };
+    inline thread_local worker_slot current_worker;
+
+    template <typename Fn> using spawn_result_t = helper::fn_eval_result_no_arg<Fn &>;
+} // namespace result_type::detail
+
+namespace result_type
+{
+    // The handle of a spawned task, move only. `join()` waits for it and
+    // returns its `Result`. A `Task` may outlive its `Executor`: the
+    // executor's destructor runs every task, and joining a finished one does
+    // not touch the executor.
+    template <typename T, typename E> class Task
+    {
+    public:
+        Task() = default;
+        Task(Task &&other) noexcept
+            : executor_{std::exchange(other.executor_, nullptr)}, state_{std::exchange(other.state_, nullptr)}
+        {
+        }
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                executor_ = std::exchange(other.executor_, nullptr);
+                state_    = std::exchange(other.state_, nullptr);
+            }
+            return *this;
+        }
+        Task(const Task &)            = delete;
+        Task &operator=(const Task &) = delete;
+        ~Task() { reset(); }
+
+        // false once joined or moved from
+        [[nodiscard]] bool valid() const noexcept { return state_ != nullptr; }
+
+        // whether `join()` would return without waiting
+        [[nodiscard]] bool is_ready() const noexcept { return state_ != nullptr && state_->done(); }
+
+        // the `Result` of the task once it has run, panics on a task that is
+        // not `valid()`
+        [[nodiscard]] Result<T, E> join();
+
+    private:
+        friend class Executor;
+
+        Task(Executor *executor, detail::task_result<T, E> *state) noexcept : executor_{executor}, state_{state} {}
+
+        void reset() noexcept
+        {
+            if (state_ != nullptr)
+            {
+                state_->release();
+                state_ = nullptr;
+            }
+        }
+
+        Executor *executor_                = nullptr;
+        detail::task_result<T, E> *state_ = nullptr;
+    };
+
+    class Executor
+    {
+    public:
+        // `threads` workers, 0 for one per hardware thread
+        explicit Executor(unsigned threads = 0)
+        {
+            const unsigned count = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+            workers_.reserve(count);
+            for (unsigned i = 0; i < count; ++i)
+            {
+                workers_.push_back(std::make_unique<worker>());
+            }
+            try
+            {
+                for (std::size_t i = 0; i < workers_.size(); ++i)
+                {
+                    workers_[i]->thread = std::thread{[this, i] { work(i); }};
+                }
+            }
+            catch (...)
+            {
+                // the workers started so far use `this`
+                stop();
+                throw;
+            }
+        }
+
+        Executor(const Executor &)            = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        ~Executor()
+        {
+            stop();
+            // anything spawned while the workers were stopping
+            while (run_one())
+            {
+            }
+        }
+
+        [[nodiscard]] std::size_t threads() const noexcept { return workers_.size(); }
+
+        // runs `fn()`, which returns a `Result`, on one of the workers
+        template <typename Fn>
+        auto spawn(Fn fn) -> Task<typename detail::spawn_result_t<Fn>::value_type,
+                                  typename detail::spawn_result_t<Fn>::error_type>
+        {
+            using R = detail::spawn_result_t<Fn>;
+            static_assert(helper::is_result_type<R>, "spawn: `fn` must return a `Result`");
+            using T = typename R::value_type;
+            using E = typename R::error_type;
+
+            auto *state = new detail::task_state<Fn, T, E>{std::move(fn)};
+            Task<T, E> task{this, state};
+            try
+            {
+                enqueue(state);
+            }
+            catch (...)
+            {
+                // the executor's reference, `task` drops its own
+                state->release();
+                throw;
+            }
+            wake_one();
+            return task;
+        }
+
+        // runs one pending task on the calling thread, false when there was
+        // none
+        bool run_one()
+        {
+            detail::task_base *task = find_work(own_index());
+            if (task == nullptr)
+            {
+                return false;
+            }
+            execute(task);
+            return true;
+        }
+
+    private:
+        template <typename T, typename E> friend class Task;
+
+        static constexpr std::size_t no_worker = std::numeric_limits<std::size_t>::max();
+        // searches, with a yield after each, before a worker goes to sleep
+        static constexpr unsigned idle_rounds  = 64;
+
+        struct worker
+        {
+            detail::work_deque deque;
+            std::thread thread;
+        };
+
+        // wakes every worker and joins the ones that were started
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            for (const auto &worker : workers_)
+            {
+                if (worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+        }
+
+        std::size_t own_index() const noexcept
+        {
+            return detail::current_worker.executor == this ? detail::current_worker.index : no_worker;
+        }
+
+        void execute(detail::task_base *task) noexcept
+        {
+            task->run();
+            task->release();
+            // pairs with the fence in `wait_for`
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (joiners_.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                finished_.notify_all();
+            }
+        }
+
+        // until `task` has finished. A worker runs other tasks meanwhile, a
+        // thread outside the pool yields for a while and then sleeps, leaving
+        // the CPUs to the workers.
+        void wait_for(const detail::task_base &task)
+        {
+            const bool worker = own_index() != no_worker;
+            unsigned idle     = 0;
+            while (!task.done())
+            {
+                if (worker)
+                {
+                    if (!run_one())
+                    {
+                        std::this_thread::yield();
+                    }
+                    continue;
+                }
+                if (++idle < idle_rounds)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock{mutex_};
+                joiners_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (!task.done())
+                {
+                    finished_.wait(lock);
+                }
+                joiners_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        // leaves `task` unqueued if it throws
+        void enqueue(detail::task_base *task)
+        {
+            const std::size_t self = own_index();
+            if (self != no_worker)
+            {
+                workers_[self]->deque.push(task);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                injected_.push_back(task);
+                injected_size_.store(injected_.size(), std::memory_order_relaxed);
+            }
+        }
+
+        // after `enqueue`: a worker about to sleep either sees the task or is
+        // counted in `sleepers_`, the fence pairs with the one in `work`;
+        // nothing shared is written while every worker is busy
+        void wake_one()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                wake_.notify_one();
+            }
+        }
+
+        // the own deque first, then tasks spawned from outside, then the
+        // other workers' deques
+        detail::task_base *find_work(std::size_t self)
+        {
+            if (self != no_worker)
+            {
+                if (detail::task_base *task = workers_[self]->deque.pop())
+                {
+                    return task;
+                }
+            }
+            if (injected_size_.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                if (!injected_.empty())
+                {
+                    detail::task_base *task = injected_.front();
+                    injected_.pop_front();
+                    injected_size_.store(injected_.size(), std::memory_order_relaxed);
+                    return task;
+                }
+            }
+            const std::size_t count = workers_.size();
+            const std::size_t first = self != no_worker ? self + 1 : 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t victim = (first + i) % count;
+                if (victim == self)
+                {
+                    continue;
+                }
+                if (detail::task_base *task = workers_[victim]->deque.steal())
+                {
+                    return task;
+                }
+            }
+            return nullptr;
+        }
+
+        void work(std::size_t index)
+        {
+            detail::current_worker = {this, index};
+            unsigned idle          = 0;
+            for (;;)
+            {
+                if (detail::task_base *task = find_work(index))
+                {
+                    execute(task);
+                    idle = 0;
+                    continue;
+                }
+                if (++idle < idle_rounds)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock{mutex_};
+                if (stopping_)
+                {
+                    return;
+                }
+                sleepers_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!has_work())
+                {
+                    wake_.wait(lock);
+                }
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+                idle = 0;
+            }
+        }
+
+        // whether a task is queued anywhere, with `mutex_` held
+        bool has_work() const noexcept
+        {
+            if (!injected_.empty())
+            {
+                return true;
+            }
+            return std::any_of(workers_.begin(), workers_.end(),
+                               [](const std::unique_ptr<worker> &other)
+                               {
+                                   return !other->deque.empty();
+                               });
+        }
+
+        std::vector<std::unique_ptr<worker>> workers_;
+
+        // mostly read, each on its own cache line so that spawning, finishing
+        // and polling for work do not contend with each other or the mutex
+        // workers sleeping on `wake_`, read by every spawn
+        alignas(64) std::atomic<unsigned> sleepers_{0};
+        // threads outside the pool sleeping in `Task::join()`, read by every
+        // finished task
+        alignas(64) std::atomic<unsigned> joiners_{0};
+        // polled by every idle worker, written with `mutex_` held
+        alignas(64) std::atomic<std::size_t> injected_size_{0};
+
+        alignas(64) std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable finished_;
+        // spawned from threads that are not workers, guarded by `mutex_`
+        std::deque<detail::task_base *> injected_;
+        bool stopping_ = false;
+    };
+
+    template <typename T, typename E> Result<T, E> Task<T, E>::join()
+    {
+        if (state_ == nullptr)
+        {
+            panic("called `Task::join()` on a `Task` that is not valid");
+        }
+        // a finished task needs nothing from its executor, which may be gone
+        if (!state_->done())
+        {
+            executor_->wait_for(*state_);
+        }
+        Result<T, E> result = state_->take();
+        reset();
+        return result;
+    }
+} // namespace result_type
+
+namespace result_type::detail
+{
+    template <typename T> using joined_values_t = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+} // namespace result_type::detail
+
+namespace result_type
+{
+    // joins every task in order, the values of all or the `Err` of the first
+    // failed one by position
+    template <typename T, typename E>
+    Result<detail::joined_values_t<T>, E> join_all(std::vector<Task<T, E>> &tasks)
+    {
+        std::optional<E> error;
+        if constexpr (std::is_void_v<T>)
+        {
+            for (Task<T, E> &task : tasks)
+            {
+                Result<T, E> result = task.join();
+                if (result.is_err() && !error)
+                {
+                    error.emplace(std::move(result).unwrap_err());
+                }
+            }
+            if (error)
+            {
+                return make_err<void, E>(std::move(*error));
+            }
+            return make_ok<void, E>();
+        }
+        else
+        {
+            std::vector<T> values;
+            values.reserve(tasks.size());
+            for (Task<T, E> &task : tasks)
+            {
+                Result<T, E> result = task.join();
+                if (error)
+                {
+                    continue;
+                }
+                if (result.is_err())
+                {
+                    error.emplace(std::move(result).unwrap_err());
+                }
+                else
+                {
+                    values.push_back(std::move(result).unwrap());
+                }
+            }
+            if (error)
+            {
+                return make_err<std::vector<T>, E>(std::move(*error));
+            }
+            return make_ok<std::vector<T>, E>(std::move(values));
+        }
+    }
+
+    // joins every task in order, the values of all or the errors of every
+    // failed one
+    template <typename T, typename E>
+    Result<detail::joined_values_t<T>, std::vector<E>> join_all_errors(std::vector<Task<T, E>> &tasks)
+    {
+        std::vector<E> errors;
+        if constexpr (std::is_void_v<T>)
+        {
+            for (Task<T, E> &task : tasks)
+            {
+                Result<T, E> result = task.join();
+                if (result.is_err())
+                {
+                    errors.push_back(std::move(result).unwrap_err());
+                }
+            }
+            if (!errors.empty())
+            {
+                return make_err<void, std::vector<E>>(std::move(errors));
+            }
+            return make_ok<void, std::vector<E>>();
+        }
+        else
+        {
+            std::vector<T> values;
+            values.reserve(tasks.size());
+            for (Task<T, E> &task : tasks)
+            {
+                Result<T, E> result = task.join();
+                if (result.is_err())
+                {
+                    errors.push_back(std::move(result).unwrap_err());
+                }
+                else if (errors.empty())
+                {
+                    values.push_back(std::move(result).unwrap());
+                }
+            }
+            if (!errors.empty())
+            {
+                return make_err<std::vector<T>, std::vector<E>>(std::move(errors));
+            }
+            return make_ok<std::vector<T>, std::vector<E>>(std::move(values));
+        }
+    }
+} // namespace result_type
@@ -0,0 +1,400 @@
+#pragma once
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-monadics.hpp"
+#include "result-type-observers.hpp"
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if !defined(__cpp_lib_atomic_wait) && defined(__linux__)
+#    include <climits>
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+// A one-shot hand-off of a `Result` from one thread to another:
+//
+// ``` cpp
+// ResultPromise<Frame, DecodeErr> promise;
+// ResultFuture<Frame, DecodeErr> frame = promise.get_future();
+// std::thread decoder{[promise = std::move(promise), &packet]() mutable { promise.set_result(decode(packet)); }};
+//
+// Result<Frame, DecodeErr> decoded = frame.get();
+// ```
+//
+// Unlike `std::promise<Result<T, E>>` there is no mutex and no
+// `std::exception_ptr`. The promise and its future share one allocation that
+// holds the `Result` inline, and `set_result` publishes it with a single
+// atomic exchange of the state word. A waiting `get()` sleeps on that word,
+// with `std::atomic::wait` from C++20 and a futex on Linux before it, and
+// `set_result` only makes the wake-up call when someone is asleep.
+//
+// `try_get()` never blocks. `then(fn)` chains `fn` like `Result::and_then`:
+// it runs on the thread that completes the promise, or right away when the
+// result is already there, and the `Result` it returns completes the future
+// `then` returns. An `Err` skips `fn` and is passed on. `fn` should be short
+// and must not throw, it runs inside `set_result`.
+//
+// A promise destroyed without a result abandons its future: `get()` and
+// `try_get()` panic, and a `then` chain passes the abandonment on.
+namespace result_type
+{
+    template <typename T, typename E> class ResultPromise;
+    template <typename T, typename E> class ResultFuture;
+} // namespace result_type
+
+namespace result_type::detail
+{
+    // until `word` no longer holds `old`, may return early
+    inline void wait_on(std::atomic<std::uint32_t> &word, std::uint32_t old) noexcept
+    {
+#if defined(__cpp_lib_atomic_wait)
+        word.wait(old, std::memory_order_acquire);
+#elif defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0);
+#else
+        while (word.load(std::memory_order_acquire) == old)
+        {
+            std::this_thread::yield();
+        }
+#endif
+    }
+
+    inline void wake_all(std::atomic<std::uint32_t> &word) noexcept
+    {
+#if defined(__cpp_lib_atomic_wait)
+        word.notify_all();
+#elif defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+    // what runs on completion after `ResultFuture::then`
+    template <typename T, typename E> class future_continuation
+    {
+    public:
+        virtual ~future_continuation() = default;
+
+        virtual void complete(Result<T, E> &&result) noexcept = 0;
+    };
+
+    // the state a promise and its future share
+    template <typename T, typename E> class future_state
+    {
+    public:
+        // one of these
+        static constexpr std::uint32_t pending   = 0;
+        static constexpr std::uint32_t ready     = 1;
+        static constexpr std::uint32_t abandoned = 2;
+        // plus any of these while pending
+        static constexpr std::uint32_t chained   = 4;
+        static constexpr std::uint32_t sleeping  = 8;
+
+        future_state()                                = default;
+        future_state(const future_state &)            = delete;
+        future_state &operator=(const future_state &) = delete;
+
+        void retain() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+        void release() noexcept
+        {
+            if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
+        }
+
+        [[nodiscard]] std::uint32_t load() const noexcept { return state_.load(std::memory_order_acquire); }
+
+        // the promise's single transition out of `pending`
+        void complete(Result<T, E> &&result) noexcept
+        {
+            ::new (static_cast<void *>(slot_)) Result<T, E>(std::move(result));
+            finish(state_.exchange(ready, std::memory_order_acq_rel), ready);
+        }
+        void abandon() noexcept { finish(state_.exchange(abandoned, std::memory_order_acq_rel), abandoned); }
+
+        // once `ready`
+        Result<T, E> &result() noexcept { return *std::launder(reinterpret_cast<Result<T, E> *>(slot_)); }
+
+        // returns false when the state is no longer pending, `next` is then
+        // the caller's to run or drop
+        bool chain(future_continuation<T, E> *next) noexcept
+        {
+            next_               = next;
+            std::uint32_t state = state_.load(std::memory_order_relaxed);
+            while ((state & (ready | abandoned)) == 0)
+            {
+                if (state_.compare_exchange_weak(state, state | chained, std::memory_order_release,
+                                                 std::memory_order_acquire))
+                {
+                    return true;
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return false;
+        }
+
+        // until `ready` or `abandoned`, spinning briefly first since the
+        // other thread is often about to finish
+        std::uint32_t wait() noexcept
+        {
+            std::uint32_t state = load();
+            for (int spin = 0; spin < spin_limit && (state & (ready | abandoned)) == 0; ++spin)
+            {
+                state = load();
+            }
+            while ((state & (ready | abandoned)) == 0)
+            {
+                if ((state & sleeping) == 0 &&
+                    !state_.compare_exchange_weak(state, state | sleeping, std::memory_order_acquire))
+                {
+                    continue;
+                }
+                wait_on(state_, state | sleeping);
+                state = load();
+            }
+            return state;
+        }
+
+    private:
+        static constexpr int spin_limit = 64;
+
+        ~future_state()
+        {
+            if (state_.load(std::memory_order_relaxed) == ready)
+            {
+                result().~Result<T, E>();
+            }
+        }
+
+        void finish(std::uint32_t before, std::uint32_t after) noexcept
+        {
+            if ((before & chained) != 0)
+            {
+                if (after == ready)
+                {
+                    next_->complete(std::move(result()));
+                }
+                delete next_;
+            }
+            if ((before & sleeping) != 0)
+            {
+                wake_all(state_);
+            }
+        }
+
+        std::atomic<std::uint32_t> state_{pending};
+        std::atomic<int> refs_{1};
+        future_continuation<T, E> *next_ = nullptr;
+        alignas(Result<T, E>) unsigned char slot_[sizeof(Result<T, E>)];
+    };
+
+    template <typename T, typename E, typename Fn>
+    using then_result_t = decltype(std::declval<Result<T, E> &&>().and_then(std::declval<Fn &>()));
+} // namespace result_type::detail
+
+namespace result_type
+{
+    template <typename T, typename E> class ResultPromise
+    {
+    public:
+        ResultPromise() : state_{new detail::future_state<T, E>} {}
+        ResultPromise(ResultPromise &&other) noexcept
+            : state_{std::exchange(other.state_, nullptr)}, future_taken_{other.future_taken_},
+              satisfied_{other.satisfied_}
+        {
+        }
+        ResultPromise &operator=(ResultPromise &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                state_        = std::exchange(other.state_, nullptr);
+                future_taken_ = other.future_taken_;
+                satisfied_    = other.satisfied_;
+            }
+            return *this;
+        }
+        ResultPromise(const ResultPromise &)            = delete;
+        ResultPromise &operator=(const ResultPromise &) = delete;
+        ~ResultPromise() { reset(); }
+
+        // the one future of this promise, panics when called twice
+        [[nodiscard]] ResultFuture<T, E> get_future()
+        {
+            if (state_ == nullptr || future_taken_)
+            {
+                panic("called `ResultPromise::get_future()` twice or on a moved from promise");
+            }
+            future_taken_ = true;
+            state_->retain();
+            return ResultFuture<T, E>{state_};
+        }
+
+        // hands `result` to the future, panics when called twice
+        void set_result(Result<T, E> result)
+        {
+            if (state_ == nullptr || satisfied_)
+            {
+                panic("called `ResultPromise::set_result()` twice or on a moved from promise");
+            }
+            satisfied_ = true;
+            state_->complete(std::move(result));
+        }
+
+    private:
+        void reset() noexcept
+        {
+            if (state_ != nullptr)
+            {
+                if (!satisfied_)
+                {
+                    state_->abandon();
+                }
+                std::exchange(state_, nullptr)->release();
+            }
+        }
+
+        detail::future_state<T, E> *state_;
+        bool future_taken_ = false;
+        bool satisfied_    = false;
+    };
+
+    template <typename T, typename E> class ResultFuture
+    {
+    public:
+        ResultFuture() = default;
+        ResultFuture(ResultFuture &&other) noexcept : state_{std::exchange(other.state_, nullptr)} {}
+        ResultFuture &operator=(ResultFuture &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                state_ = std::exchange(other.state_, nullptr);
+            }
+            return *this;
+        }
+        ResultFuture(const ResultFuture &)            = delete;
+        ResultFuture &operator=(const ResultFuture &) = delete;
+        ~ResultFuture() { reset(); }
+
+        // false once the result was taken, or after `then`
+        [[nodiscard]] bool valid() const noexcept { return state_ != nullptr; }
+
+        // whether the promise is done, with a result or abandoned
+        [[nodiscard]] bool is_ready() const noexcept
+        {
+            return state_ != nullptr && (state_->load() & (state::ready | state::abandoned)) != 0;
+        }
+
+        void wait() const
+        {
+            check("wait");
+            state_->wait();
+        }
+
+        // the result, waiting for it
+        [[nodiscard]] Result<T, E> get()
+        {
+            check("get");
+            return take(state_->wait(), "get");
+        }
+
+        // the result if it is there, without waiting
+        [[nodiscard]] std::optional<Result<T, E>> try_get()
+        {
+            check("try_get");
+            const std::uint32_t current = state_->load();
+            if ((current & (state::ready | state::abandoned)) == 0)
+            {
+                return std::nullopt;
+            }
+            return take(current, "try_get");
+        }
+
+        // `result.and_then(fn)` as a future, `fn` running on the completing
+        // thread; this future is no longer `valid()` afterwards
+        template <typename Fn> [[nodiscard]] auto then(Fn fn) -> ResultFuture<
+            typename detail::then_result_t<T, E, Fn>::value_type, typename detail::then_result_t<T, E, Fn>::error_type>
+        {
+            using R = detail::then_result_t<T, E, Fn>;
+            check("then");
+
+            ResultPromise<typename R::value_type, typename R::error_type> next;
+            auto future  = next.get_future();
+            auto *linked = new link<Fn, R>{std::move(fn), std::move(next)};
+            if (!state_->chain(linked))
+            {
+                if ((state_->load() & state::ready) != 0)
+                {
+                    linked->complete(std::move(state_->result()));
+                }
+                delete linked;
+            }
+            reset();
+            return future;
+        }
+
+    private:
+        friend class ResultPromise<T, E>;
+        using state = detail::future_state<T, E>;
+
+        // completes a `then` future
+        template <typename Fn, typename R> class link final : public detail::future_continuation<T, E>
+        {
+        public:
+            link(Fn &&fn, ResultPromise<typename R::value_type, typename R::error_type> &&next)
+                : fn_{std::move(fn)}, next_{std::move(next)}
+            {
+            }
+
+            void complete(Result<T, E> &&result) noexcept override
+            {
+                next_.set_result(std::move(result).and_then(fn_));
+            }
+
+        private:
+            Fn fn_;
+            ResultPromise<typename R::value_type, typename R::error_type> next_;
+        };
+
+        explicit ResultFuture(state *shared) noexcept : state_{shared} {}
+
+        void check(const char *what) const
+        {
+            if (state_ == nullptr)
+            {
+                panic("called `ResultFuture::", what, "()` on a future that is not valid");
+            }
+        }
+
+        Result<T, E> take(std::uint32_t current, const char *what)
+        {
+            if ((current & state::ready) == 0)
+            {
+                panic("called `ResultFuture::", what, "()` on the future of an abandoned `ResultPromise`");
+            }
+            Result<T, E> result = std::move(state_->result());
+            reset();
+            return result;
+        }
+
+        void reset() noexcept
+        {
+            if (state_ != nullptr)
+            {
+                std::exchange(state_, nullptr)->release();
+            }
+        }
+
+        state *state_ = nullptr;
+    };
+} // namespace result_type
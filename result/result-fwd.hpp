@@ -0,0 +1,20 @@
+#pragma once
+
+// Declarations of `Result`, `Ok` and `Err` without their definitions and
+// without any standard header, for headers that only name the types, e.g.
+// in function declarations:
+//
+// ``` cpp
+// #include "result/result-fwd.hpp"
+//
+// result_type::Result<Config, ErrCode> load(std::string_view path);
+// ```
+//
+// Calling such a function, or defining it, needs result/result.hpp.
+
+namespace result_type
+{
+    template <typename T, typename E> class Result;
+    template <typename T> struct Ok;
+    template <typename E> struct Err;
+} // namespace result_type
@@ -1,11 +1,14 @@
 #pragma once
-#include <sstream>
+#include "result-debug.hpp"
+#include "result-fwd.hpp"
 #include <type_traits>
 
-namespace result_type
-{
-    template <typename T, typename E> class Result;
-}
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L && __cplusplus > 201703L && __has_include(<concepts>)
+#    include <concepts>
+#    define RESULT_USE_CONCEPTS 1
+#else
+#    define RESULT_USE_CONCEPTS 0
+#endif
 
 namespace result_type::helper
 {
@@ -43,23 +46,68 @@ namespace result_type::helper
     using transform_err_enable_t =
         std::enable_if_t<std::is_constructible_v<T, Tp>, Result<T, fn_eval_result_xform<Fn, FnArg>>>;
 
+#if RESULT_USE_CONCEPTS
+    // C++20 counterparts of the `*_enable_t` aliases above, named so that
+    // errors say which requirement a callable misses.
+    template <typename T, typename From>
+    concept constructible_from = std::is_constructible_v<T, From>;
+
+    template <typename Fn, typename FnArg, typename Keep, typename KeepFrom>
+    concept monadic_callable = std::invocable<Fn, FnArg> && constructible_from<Keep, KeepFrom>;
+
+    template <typename Fn, typename Keep, typename KeepFrom>
+    concept monadic_callable_no_arg = std::invocable<Fn> && constructible_from<Keep, KeepFrom>;
+#endif
+
+// The return type and constraint of each monadic member, written after its
+// declarator.
+//
+// With concepts the return type is followed by a requires-clause, so a
+// callable that does not fit is reported as the unsatisfied concept rather
+// than as a failed `std::enable_if_t`. The return types are the same as in
+// C++17, only the diagnostics change: the constraints are checked before
+// the return type is formed. C++17 keeps the `std::enable_if_t` return types.
+#if RESULT_USE_CONCEPTS
+#    define RESULT_ENABLE_MONADIC(Keep, Fn, KeepFrom, FnArg)                                                           \
+        ->::result_type::helper::fn_eval_result<Fn, FnArg>                                                             \
+            requires ::result_type::helper::monadic_callable<Fn, FnArg, Keep, KeepFrom>
+#    define RESULT_ENABLE_MONADIC_NO_ARG(Keep, Fn, KeepFrom)                                                           \
+        ->::result_type::helper::fn_eval_result_no_arg<Fn>                                                             \
+            requires ::result_type::helper::monadic_callable_no_arg<Fn, Keep, KeepFrom>
+#    define RESULT_ENABLE_TRANSFORM(Keep, Fn, KeepFrom, FnArg)                                                         \
+        ->::result_type::Result<::result_type::helper::fn_eval_result_xform<Fn, FnArg>, Keep>                          \
+            requires ::result_type::helper::monadic_callable<Fn, FnArg, Keep, KeepFrom>
+#    define RESULT_ENABLE_TRANSFORM_NO_ARG(Keep, Fn, KeepFrom)                                                         \
+        ->::result_type::Result<::result_type::helper::fn_eval_result_xform_no_arg<Fn>, Keep>                          \
+            requires ::result_type::helper::monadic_callable_no_arg<Fn, Keep, KeepFrom>
+#    define RESULT_ENABLE_TRANSFORM_ERR(Keep, Fn, KeepFrom, FnArg)                                                     \
+        ->::result_type::Result<Keep, ::result_type::helper::fn_eval_result_xform<Fn, FnArg>>                          \
+            requires ::result_type::helper::monadic_callable<Fn, FnArg, Keep, KeepFrom>
+#    define RESULT_ENABLE_INVOKE(Fn, FnArg)                                                                            \
+        ->::result_type::helper::fn_eval_result<Fn, FnArg> requires std::invocable<Fn, FnArg>
+#    define RESULT_ENABLE_TRANSFORM_ERR_VOID(Fn, FnArg)                                                                \
+        ->::result_type::Result<void, ::result_type::helper::fn_eval_result_xform<Fn, FnArg>>                          \
+            requires std::invocable<Fn, FnArg>
+#else
+#    define RESULT_ENABLE_MONADIC(Keep, Fn, KeepFrom, FnArg)                                                           \
+        ->::result_type::helper::monadic_enable_t<Keep, Fn, KeepFrom, FnArg>
+#    define RESULT_ENABLE_MONADIC_NO_ARG(Keep, Fn, KeepFrom)                                                           \
+        ->::result_type::helper::monadic_no_arg_enable_t<Keep, Fn, KeepFrom>
+#    define RESULT_ENABLE_TRANSFORM(Keep, Fn, KeepFrom, FnArg)                                                         \
+        ->::result_type::helper::transform_enable_t<Keep, Fn, KeepFrom, FnArg>
+#    define RESULT_ENABLE_TRANSFORM_NO_ARG(Keep, Fn, KeepFrom)                                                         \
+        ->::result_type::helper::transform_no_arg_enable_t<Keep, Fn, KeepFrom>
+#    define RESULT_ENABLE_TRANSFORM_ERR(Keep, Fn, KeepFrom, FnArg)                                                     \
+        ->::result_type::helper::transform_err_enable_t<Keep, Fn, KeepFrom, FnArg>
+#    define RESULT_ENABLE_INVOKE(Fn, FnArg) ->::result_type::helper::fn_eval_result<Fn, FnArg>
+#    define RESULT_ENABLE_TRANSFORM_ERR_VOID(Fn, FnArg)                                                                \
+        ->::result_type::Result<void, ::result_type::helper::fn_eval_result_xform<Fn, FnArg>>
+#endif
+
     template <typename T>
     constexpr bool movable = std::is_object<T>::value && std::is_move_constructible<T>::value &&
                              std::is_assignable<T &, T>::value && std::is_swappable<T>::value;
 
-    // Primary template (false case)
-    template <typename T, typename = void> struct is_streamable : std::false_type
-    {
-    };
-
-    // Specialization using SFINAE
-    template <typename T>
-    struct is_streamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<T>())>> : std::true_type
-    {
-    };
-
-    template <typename T> constexpr bool is_streamable_v = is_streamable<T>::value;
-
     template <typename T> struct check_value_type
     {
         static_assert(movable<T>, "Value type `T` for `Result`, `Ok` and `Err` must be movable");
@@ -67,8 +115,10 @@ namespace result_type::helper
                       "Cannot use a reference for value type `T` for `Result`, `Ok` and `Err`, To "
                       "prevent subtleties use type wrappers like std::reference_wrapper instead");
         static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow move constructible");
-        static_assert(is_streamable_v<T>,
-                      "`T` must have a `operator<<` overload to satisfy debug traits of `Panic` handler");
+        static_assert(is_debuggable_v<T>,
+                      "`T` must satisfy `result_type::result_debug` to be printed by the `Panic` handler: "
+                      "specialize it, or give `T` an `operator<<` or `to_chars` found by ADL, see "
+                      "result-debug.hpp for the other options");
     };
 
     template <typename E> struct check_error_type
@@ -78,7 +128,9 @@ namespace result_type::helper
                       "Cannot use a reference for value type `E` for `Result`, `Ok` and `Err`, To "
                       "prevent subtleties use type wrappers like std::reference_wrapper instead");
         static_assert(std::is_nothrow_move_constructible_v<E>, "E must be nothrow move constructible");
-        static_assert(is_streamable_v<E>,
-                      "`E` must have a `operator<<` overload to satisfy debug traits of `Panic` handler");
+        static_assert(is_debuggable_v<E>,
+                      "`E` must satisfy `result_type::result_debug` to be printed by the `Panic` handler: "
+                      "specialize it, or give `E` an `operator<<` or `to_chars` found by ADL, see "
+                      "result-debug.hpp for the other options");
     };
 } // namespace result_type::helper
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+namespace result_type
+{
+    // Opt-in customization point that lets `Result` store its discriminant in
+    // an invalid bit pattern ("niche") of a payload type, the way Rust packs
+    // `Option<&T>` into a single pointer.
+    //
+    // A specialization declares one value of `T` that never appears as a real
+    // payload:
+    //
+    // ``` cpp
+    // template <> struct result_type::niche_traits<Widget *> : result_type::null_pointer_niche<Widget *>
+    // {
+    // };
+    // ```
+    //
+    // or spells the members out by hand:
+    //
+    //     static constexpr bool available = true;
+    //     static constexpr T niche() noexcept;                // produces the invalid value
+    //     static constexpr bool is_niche(const T &) noexcept; // recognizes it
+    //
+    // When one side of `Result<T, E>` has a niche and the other side is an
+    // empty type (including the `Ok` side of `Result<void, E>`), the tag is
+    // dropped and `sizeof(Result<T, E>) == sizeof(T)`. Storing the niche value
+    // itself as a payload is a contract violation, it reads back as the other
+    // alternative.
+    template <typename T, typename = void> struct niche_traits
+    {
+        static constexpr bool available = false;
+    };
+
+    // `nullptr` is never a valid value of the pointer-like `P`
+    template <typename P> struct null_pointer_niche
+    {
+        static constexpr bool available = true;
+        static constexpr P niche() noexcept { return P{}; }
+        static constexpr bool is_niche(const P &ptr) noexcept { return ptr == nullptr; }
+    };
+
+    // the enumerator value `Value` is never used by `Enum`
+    template <typename Enum, Enum Value> struct enum_value_niche
+    {
+        static_assert(std::is_enum_v<Enum>, "`enum_value_niche` only applies to enumerations");
+
+        static constexpr bool available = true;
+        static constexpr Enum niche() noexcept { return Value; }
+        static constexpr bool is_niche(const Enum &value) noexcept { return value == Value; }
+    };
+
+    // the raw pointer `P` is always suitably aligned, so an address with the
+    // low alignment bits set is free. `nullptr` stays a valid payload.
+    template <typename P> struct misaligned_pointer_niche
+    {
+        static_assert(std::is_pointer_v<P> && alignof(std::remove_pointer_t<P>) > 1,
+                      "`misaligned_pointer_niche` needs a pointer to an over-aligned type");
+
+        static constexpr bool available = true;
+        static P niche() noexcept { return reinterpret_cast<P>(std::uintptr_t{1}); }
+        static bool is_niche(const P &ptr) noexcept { return reinterpret_cast<std::uintptr_t>(ptr) == 1; }
+    };
+} // namespace result_type
@@ -0,0 +1,268 @@
+#pragma once
+#include "result-executor.hpp"
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-observers.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fallible element wise work over a random access range, split across
+// threads, stopping everyone on an `Err`:
+//
+// ``` cpp
+// std::vector<Record> records(rows.size());
+// Result<void, ValidationErr> checked =
+//     parallel::try_transform(rows.begin(), rows.end(), records.begin(), validate);
+//
+// Result<void, ValidationErr> all_valid = parallel::try_for_each(records.begin(), records.end(), check_invariants);
+// ```
+//
+// Workers claim chunks of `options::grain` consecutive elements from a shared
+// counter, so uneven costs balance out. The calling thread is one of the
+// workers. The others run as tasks of `options::executor` when one is given,
+// and are threads started for the call otherwise; either way they are joined
+// before it returns. A range of a single chunk runs on the calling thread
+// alone. If fewer workers than wanted can be started, the ones that are take
+// over their chunks. `fn` is called from several threads at once. An
+// exception escaping it terminates, as with the standard parallel algorithms.
+//
+// The first `Err` is published to the other workers through one atomic
+// index they test before every element. With `error_order::lowest_index` the
+// result is the `Err` a sequential loop would have returned: elements past
+// a failed one are skipped, those before it still run since one of them may
+// fail as well. `error_order::first_observed` returns whichever `Err` was
+// found first and stops all workers on it.
+//
+// `try_transform` assigns the value of every `Ok` to the element of `out` at
+// the same index, `out` being a random access iterator to at least as many
+// elements. After an `Err` some of them are written and some are not.
+namespace result_type::parallel
+{
+    // which `Err` is returned when several elements fail
+    enum class error_order : std::uint8_t
+    {
+        lowest_index,
+        first_observed,
+    };
+
+    struct options
+    {
+        // workers, the calling thread included, 0 for one per hardware thread
+        // or, with an `executor`, one per executor thread and the caller
+        unsigned threads   = 0;
+        // elements claimed at a time, 0 for 16 chunks per worker
+        std::size_t grain  = 0;
+        error_order order  = error_order::lowest_index;
+        // runs the workers besides the calling thread instead of threads
+        // started for the call, has to outlive it
+        Executor *executor = nullptr;
+    };
+} // namespace result_type::parallel
+
+namespace result_type::detail
+{
+    // The `Err` a parallel algorithm returns, and the index of its element
+    // for the workers to test against
+    template <typename E> class parallel_error
+    {
+    public:
+        static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+        explicit parallel_error(parallel::error_order order) noexcept : order_{order} {}
+
+        // whether element `index` still has to run
+        [[nodiscard]] bool wanted(std::size_t index) const noexcept
+        {
+            const std::size_t failed = failed_.load(std::memory_order_relaxed);
+            return order_ == parallel::error_order::lowest_index ? index < failed : failed == none;
+        }
+
+        void report(std::size_t index, E &&error)
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            const std::size_t failed = failed_.load(std::memory_order_relaxed);
+            if (order_ == parallel::error_order::lowest_index ? index < failed : failed == none)
+            {
+                error_.emplace(std::move(error));
+                failed_.store(index, std::memory_order_relaxed);
+            }
+        }
+
+        // after every worker is joined
+        Result<void, E> take()
+        {
+            if (error_)
+            {
+                return make_err<void, E>(std::move(*error_));
+            }
+            return make_ok<void, E>();
+        }
+
+    private:
+        parallel::error_order order_;
+        std::atomic<std::size_t> failed_{none};
+        std::mutex mutex_;
+        std::optional<E> error_;
+    };
+
+    // `body(first, last)` for chunks of [0, count) on `options::threads`
+    // workers, returns once every chunk has been claimed and run
+    template <typename Body> void run_chunks(std::size_t count, const parallel::options &opts, Body &body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        const unsigned available = opts.executor != nullptr
+                                       ? static_cast<unsigned>(opts.executor->threads()) + 1
+                                       : std::max(1u, std::thread::hardware_concurrency());
+        const unsigned wanted    = opts.threads != 0 ? opts.threads : available;
+        const std::size_t grain =
+            opts.grain != 0 ? opts.grain : std::max<std::size_t>(1, count / (std::size_t{wanted} * 16));
+        const std::size_t chunks = (count - 1) / grain + 1;
+        const auto threads       = static_cast<unsigned>(std::min<std::size_t>(wanted, chunks));
+
+        std::atomic<std::size_t> next{0};
+        auto work = [&]
+        {
+            for (;;)
+            {
+                const std::size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks)
+                {
+                    return;
+                }
+                const std::size_t first = chunk * grain;
+                body(first, std::min(count, first + grain));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<Task<void, int>> tasks;
+        try
+        {
+            if (opts.executor != nullptr)
+            {
+                tasks.reserve(threads - 1);
+                for (unsigned i = 1; i < threads; ++i)
+                {
+                    tasks.push_back(opts.executor->spawn(
+                        [&work]
+                        {
+                            work();
+                            return make_ok<void, int>();
+                        }));
+                }
+            }
+            else
+            {
+                workers.reserve(threads - 1);
+                for (unsigned i = 1; i < threads; ++i)
+                {
+                    workers.emplace_back(work);
+                }
+            }
+        }
+        // out of threads or memory, the workers started so far and this one
+        // claim every chunk between them
+        catch (const std::system_error &)
+        {
+        }
+        catch (const std::bad_alloc &)
+        {
+        }
+        work();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        for (Task<void, int> &task : tasks)
+        {
+            (void)task.join();
+        }
+    }
+
+    template <typename It>
+    constexpr bool is_random_access_v =
+        std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+    template <typename Fn, typename It>
+    using parallel_result_t = helper::remove_cvref_t<std::invoke_result_t<Fn &, decltype(*std::declval<It &>())>>;
+} // namespace result_type::detail
+
+namespace result_type::parallel
+{
+    // `*(out + i) = fn(*(first + i)).unwrap()` for every element until an
+    // `fn` returns `Err`, which is the result
+    template <typename InputIt, typename OutputIt, typename Fn>
+    auto try_transform(InputIt first, InputIt last, OutputIt out, Fn fn, options opts = {})
+        -> Result<void, typename detail::parallel_result_t<Fn, InputIt>::error_type>
+    {
+        using R = detail::parallel_result_t<Fn, InputIt>;
+        using E = typename R::error_type;
+        static_assert(helper::is_result_type<R>, "try_transform: `fn` must return a `Result`");
+        static_assert(!std::is_void_v<typename R::value_type>, "try_transform: `fn` must return a value");
+        static_assert(detail::is_random_access_v<InputIt> && detail::is_random_access_v<OutputIt>,
+                      "try_transform: both ranges must be random access");
+
+        detail::parallel_error<E> error{opts.order};
+        auto body = [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end && error.wanted(i); ++i)
+            {
+                const auto offset = static_cast<typename std::iterator_traits<InputIt>::difference_type>(i);
+                R result          = std::invoke(fn, first[offset]);
+                if (result.is_err())
+                {
+                    error.report(i, std::move(result).unwrap_err());
+                    return;
+                }
+                out[static_cast<typename std::iterator_traits<OutputIt>::difference_type>(i)] =
+                    std::move(result).unwrap();
+            }
+        };
+        detail::run_chunks(static_cast<std::size_t>(last - first), opts, body);
+        return error.take();
+    }
+
+    // `fn(*(first + i))` for every element until one returns `Err`, which is
+    // the result; the values of `Ok`s are dropped
+    template <typename It, typename Fn>
+    auto try_for_each(It first, It last, Fn fn, options opts = {})
+        -> Result<void, typename detail::parallel_result_t<Fn, It>::error_type>
+    {
+        using R = detail::parallel_result_t<Fn, It>;
+        using E = typename R::error_type;
+        static_assert(helper::is_result_type<R>, "try_for_each: `fn` must return a `Result`");
+        static_assert(detail::is_random_access_v<It>, "try_for_each: the range must be random access");
+
+        detail::parallel_error<E> error{opts.order};
+        auto body = [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end && error.wanted(i); ++i)
+            {
+                R result = std::invoke(fn, first[static_cast<typename std::iterator_traits<It>::difference_type>(i)]);
+                if (result.is_err())
+                {
+                    error.report(i, std::move(result).unwrap_err());
+                    return;
+                }
+            }
+        };
+        detail::run_chunks(static_cast<std::size_t>(last - first), opts, body);
+        return error.take();
+    }
+} // namespace result_type::parallel
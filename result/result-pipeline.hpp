@@ -0,0 +1,300 @@
+#pragma once
+#include "result-helper.hpp"
+#include "result-type-definition.hpp"
+#include "result-type-monadics.hpp"
+#include "result-type-observers.hpp"
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Lazy counterparts of `and_then`, `map`, `or_else` and `map_err`.
+//
+// ``` cpp
+// auto total = read_config() | lazy::and_then(parse) | lazy::map(normalize) | lazy::or_else(use_default);
+// ```
+//
+// `total` is a pipeline, not a `Result`. Nothing runs until it is converted
+// to its `Result` (or `eval()`-ed); then the source's tag is tested once and
+// every stage hands its value straight to the next, so only the `Result`s
+// returned by `and_then` / `or_else` callables are ever tested again and no
+// intermediate `Result` is built. The outcome is the same as calling the
+// member functions one after another.
+//
+// A pipeline moves an rvalue source into itself, so `total` above is safe to
+// keep around. An lvalue source is only referenced and has to outlive the
+// pipeline. Stages hold copies of their callables and can be composed ahead
+// of time, `lazy::map(f) | lazy::map(g)`.
+namespace result_type::detail
+{
+    enum class stage_kind
+    {
+        and_then,
+        map,
+        or_else,
+        map_err,
+    };
+
+    template <stage_kind K, typename F> struct stage
+    {
+        static constexpr stage_kind kind = K;
+
+        F fn;
+    };
+
+    template <typename... Stages> struct stage_list
+    {
+        std::tuple<Stages...> stages;
+    };
+
+    template <typename T> using unit_if_void = std::conditional_t<std::is_void_v<T>, unit, T>;
+    template <typename T> using void_if_unit = std::conditional_t<std::is_same_v<T, unit>, void, T>;
+
+    // calls a value stage, `unit` stands in for the value of a `Result<void, E>`
+    template <typename F, typename V> constexpr decltype(auto) invoke_ok(F &f, V &&value)
+    {
+        if constexpr (std::is_same_v<helper::remove_cvref_t<V>, unit>)
+        {
+            return std::invoke(f);
+        }
+        else
+        {
+            return std::invoke(f, std::forward<V>(value));
+        }
+    }
+
+    template <typename F, typename V> using invoke_ok_t = decltype(invoke_ok(std::declval<F &>(), std::declval<V>()));
+
+    // the `Ok` / `Err` argument types after a stage, given the ones before it
+    template <typename Stage, typename V, typename G> struct stage_step;
+
+    template <typename F, typename V, typename G> struct stage_step<stage<stage_kind::and_then, F>, V, G>
+    {
+        using returned = helper::remove_cvref_t<invoke_ok_t<F, V>>;
+        static_assert(helper::is_result_type<returned>, "`and_then` callables must return a `Result`");
+        static_assert(std::is_same_v<typename returned::error_type, helper::remove_cvref_t<G>>,
+                      "`and_then` callables must keep the error type");
+
+        using ok_type  = unit_if_void<typename returned::value_type> &&;
+        using err_type = G;
+    };
+
+    template <typename F, typename V, typename G> struct stage_step<stage<stage_kind::map, F>, V, G>
+    {
+        using ok_type  = unit_if_void<std::remove_cv_t<invoke_ok_t<F, V>>> &&;
+        using err_type = G;
+    };
+
+    template <typename F, typename V, typename G> struct stage_step<stage<stage_kind::or_else, F>, V, G>
+    {
+        using returned = helper::remove_cvref_t<std::invoke_result_t<F &, G>>;
+        static_assert(helper::is_result_type<returned>, "`or_else` callables must return a `Result`");
+        static_assert(std::is_same_v<unit_if_void<typename returned::value_type>, helper::remove_cvref_t<V>>,
+                      "`or_else` callables must keep the value type");
+
+        using ok_type  = V;
+        using err_type = typename returned::error_type &&;
+    };
+
+    template <typename F, typename V, typename G> struct stage_step<stage<stage_kind::map_err, F>, V, G>
+    {
+        using ok_type  = V;
+        using err_type = std::remove_cv_t<std::invoke_result_t<F &, G>> &&;
+    };
+
+    template <typename V, typename G, typename... Stages> struct pipeline_output
+    {
+        using type = Result<void_if_unit<helper::remove_cvref_t<V>>, helper::remove_cvref_t<G>>;
+    };
+    template <typename V, typename G, typename Stage, typename... Rest> struct pipeline_output<V, G, Stage, Rest...>
+    {
+        using step = stage_step<Stage, V, G>;
+        using type = typename pipeline_output<typename step::ok_type, typename step::err_type, Rest...>::type;
+    };
+
+    // `Ok` / `Err` arguments a `Result` hands to the first stage
+    template <typename Source> using source_ok_t = decltype(std::declval<Source>().unwrap());
+    template <typename Source>
+    using source_ok_arg_t = std::conditional_t<std::is_void_v<source_ok_t<Source>>, unit &&, source_ok_t<Source>>;
+    template <typename Source> using source_err_arg_t = decltype(std::declval<Source>().unwrap_err());
+
+    template <typename Output, std::size_t I, typename Stages, typename V>
+    constexpr Output run_ok(Stages &stages, V &&value);
+    template <typename Output, std::size_t I, typename Stages, typename G>
+    constexpr Output run_err(Stages &stages, G &&err);
+
+    // Continuation passing evaluation: the value travels down the stages as
+    // a function argument, a tag is only tested where a `Result` comes back
+    // from a callable.
+    template <typename Output, std::size_t I, typename Stages, typename V>
+    constexpr Output run_ok(Stages &stages, V &&value)
+    {
+        if constexpr (I == std::tuple_size_v<Stages>)
+        {
+            if constexpr (std::is_void_v<typename Output::value_type>)
+            {
+                return Output(in_place_ok);
+            }
+            else
+            {
+                return Output(in_place_ok, std::forward<V>(value));
+            }
+        }
+        else
+        {
+            auto &current       = std::get<I>(stages);
+            using current_stage = std::tuple_element_t<I, Stages>;
+            if constexpr (current_stage::kind == stage_kind::and_then)
+            {
+                auto returned = invoke_ok(current.fn, std::forward<V>(value));
+                if (returned.is_err())
+                {
+                    return run_err<Output, I + 1>(stages, std::move(returned).unwrap_err());
+                }
+                if constexpr (std::is_void_v<typename decltype(returned)::value_type>)
+                {
+                    return run_ok<Output, I + 1>(stages, unit{});
+                }
+                else
+                {
+                    return run_ok<Output, I + 1>(stages, std::move(returned).unwrap());
+                }
+            }
+            else if constexpr (current_stage::kind == stage_kind::map)
+            {
+                if constexpr (std::is_void_v<invoke_ok_t<decltype(current.fn), V &&>>)
+                {
+                    invoke_ok(current.fn, std::forward<V>(value));
+                    return run_ok<Output, I + 1>(stages, unit{});
+                }
+                else
+                {
+                    return run_ok<Output, I + 1>(stages, invoke_ok(current.fn, std::forward<V>(value)));
+                }
+            }
+            else
+            {
+                return run_ok<Output, I + 1>(stages, std::forward<V>(value));
+            }
+        }
+    }
+
+    template <typename Output, std::size_t I, typename Stages, typename G>
+    constexpr Output run_err(Stages &stages, G &&err)
+    {
+        if constexpr (I == std::tuple_size_v<Stages>)
+        {
+            return Output(in_place_err, std::forward<G>(err));
+        }
+        else
+        {
+            auto &current       = std::get<I>(stages);
+            using current_stage = std::tuple_element_t<I, Stages>;
+            if constexpr (current_stage::kind == stage_kind::or_else)
+            {
+                auto returned = std::invoke(current.fn, std::forward<G>(err));
+                if (returned.is_ok())
+                {
+                    if constexpr (std::is_void_v<typename decltype(returned)::value_type>)
+                    {
+                        return run_ok<Output, I + 1>(stages, unit{});
+                    }
+                    else
+                    {
+                        return run_ok<Output, I + 1>(stages, std::move(returned).unwrap());
+                    }
+                }
+                return run_err<Output, I + 1>(stages, std::move(returned).unwrap_err());
+            }
+            else if constexpr (current_stage::kind == stage_kind::map_err)
+            {
+                return run_err<Output, I + 1>(stages, std::invoke(current.fn, std::forward<G>(err)));
+            }
+            else
+            {
+                return run_err<Output, I + 1>(stages, std::forward<G>(err));
+            }
+        }
+    }
+
+    // `Source` is an lvalue reference to the source `Result`, or its type
+    // when it was an rvalue and is held by value; either way it is forwarded
+    // to the first stage with its original value category
+    template <typename Source, typename... Stages> class [[nodiscard]] pipeline
+    {
+    public:
+        using output_type = typename pipeline_output<source_ok_arg_t<Source &&>, source_err_arg_t<Source &&>,
+                                                     Stages...>::type;
+
+        constexpr pipeline(Source &&source, std::tuple<Stages...> stages)
+            : source_(std::forward<Source>(source)), stages_(std::move(stages))
+        {
+        }
+
+        // runs every stage, the pipeline is consumed
+        constexpr output_type eval() &&
+        {
+            if (source_.is_err())
+            {
+                return run_err<output_type, 0>(stages_, std::forward<Source>(source_).unwrap_err());
+            }
+            if constexpr (std::is_void_v<source_ok_t<Source &&>>)
+            {
+                return run_ok<output_type, 0>(stages_, unit{});
+            }
+            else
+            {
+                return run_ok<output_type, 0>(stages_, std::forward<Source>(source_).unwrap());
+            }
+        }
+
+        constexpr operator output_type() && { return std::move(*this).eval(); }
+
+        template <typename... More> friend constexpr auto operator|(pipeline &&self, stage_list<More...> more)
+        {
+            return pipeline<Source, Stages..., More...>(std::forward<Source>(self.source_),
+                                                        std::tuple_cat(std::move(self.stages_),
+                                                                       std::move(more.stages)));
+        }
+
+    private:
+        std::conditional_t<std::is_lvalue_reference_v<Source>, Source, std::remove_cv_t<Source>> source_;
+        std::tuple<Stages...> stages_;
+    };
+
+    template <typename... Lhs, typename... Rhs>
+    constexpr stage_list<Lhs..., Rhs...> operator|(stage_list<Lhs...> lhs, stage_list<Rhs...> rhs)
+    {
+        return {std::tuple_cat(std::move(lhs.stages), std::move(rhs.stages))};
+    }
+
+    template <typename R, typename... Stages,
+              typename = std::enable_if_t<helper::is_result_type<helper::remove_cvref_t<R>>>>
+    constexpr auto operator|(R &&source, stage_list<Stages...> stages)
+    {
+        return pipeline<R, Stages...>(std::forward<R>(source), std::move(stages.stages));
+    }
+} // namespace result_type::detail
+
+namespace result_type::lazy
+{
+    template <detail::stage_kind K, typename F> using stage_of = detail::stage_list<detail::stage<K, std::decay_t<F>>>;
+
+    template <typename F> constexpr auto and_then(F &&f) -> stage_of<detail::stage_kind::and_then, F>
+    {
+        return {{{std::forward<F>(f)}}};
+    }
+    template <typename F> constexpr auto map(F &&f) -> stage_of<detail::stage_kind::map, F>
+    {
+        return {{{std::forward<F>(f)}}};
+    }
+    template <typename F> constexpr auto or_else(F &&f) -> stage_of<detail::stage_kind::or_else, F>
+    {
+        return {{{std::forward<F>(f)}}};
+    }
+    template <typename F> constexpr auto map_err(F &&f) -> stage_of<detail::stage_kind::map_err, F>
+    {
+        return {{{std::forward<F>(f)}}};
+    }
+} // namespace result_type::lazy
@@ -0,0 +1,518 @@
+#pragma once
+#include "result-niche.hpp"
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace result_type::detail
+{
+    enum ResultKind : std::uint8_t
+    {
+        Ok = 0,
+        Err,
+        // no active member, only while a copy or move is being constructed
+        Empty,
+    };
+
+    // stand-in payload for the `Ok` side of `Result<void, E>`
+    struct unit
+    {
+    };
+
+    // constructs alternative `K` from `std::invoke(f, args...)`, so the
+    // returned prvalue initializes the storage without an intermediate move
+    template <ResultKind K> struct from_invoke_t
+    {
+        explicit from_invoke_t() = default;
+    };
+    template <ResultKind K> inline constexpr from_invoke_t<K> from_invoke{};
+
+    template <typename T, typename E>
+    constexpr bool trivially_destructible = std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool trivially_copy_constructible =
+        std::is_trivially_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool trivially_move_constructible =
+        std::is_trivially_move_constructible_v<T> && std::is_trivially_move_constructible_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool trivially_copy_assignable = trivially_destructible<T, E> && trivially_copy_constructible<T, E> &&
+                                               std::is_trivially_copy_assignable_v<T> &&
+                                               std::is_trivially_copy_assignable_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool trivially_move_assignable = trivially_destructible<T, E> && trivially_move_constructible<T, E> &&
+                                               std::is_trivially_move_assignable_v<T> &&
+                                               std::is_trivially_move_assignable_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool copy_constructible = std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E>;
+
+    template <typename T, typename E>
+    constexpr bool copy_assignable =
+        copy_constructible<T, E> && std::is_copy_assignable_v<T> && std::is_copy_assignable_v<E>;
+
+    // how a special member of the storage is provided
+    enum class special_member
+    {
+        trivial,
+        user_defined,
+        deleted,
+    };
+
+    template <bool Trivial, bool Available>
+    constexpr special_member select_special_member =
+        Trivial ? special_member::trivial : (Available ? special_member::user_defined : special_member::deleted);
+
+    /////////////////////////////////////////////////////////////////////////
+    // raw union, only trivially destructible when both members are
+    /////////////////////////////////////////////////////////////////////////
+
+    template <typename T, typename E, bool = trivially_destructible<T, E>> union raw_union
+    {
+        unsigned char none_;
+        T ok_;
+        E err_;
+
+        constexpr raw_union() noexcept : none_{} {}
+
+        template <typename... Args>
+        constexpr explicit raw_union(std::in_place_index_t<ResultKind::Ok>, Args &&...args)
+            : ok_(std::forward<Args>(args)...)
+        {
+        }
+        template <typename... Args>
+        constexpr explicit raw_union(std::in_place_index_t<ResultKind::Err>, Args &&...args)
+            : err_(std::forward<Args>(args)...)
+        {
+        }
+
+        template <typename F, typename... Args>
+        constexpr explicit raw_union(from_invoke_t<ResultKind::Ok>, F &&f, Args &&...args)
+            : ok_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
+        {
+        }
+        template <typename F, typename... Args>
+        constexpr explicit raw_union(from_invoke_t<ResultKind::Err>, F &&f, Args &&...args)
+            : err_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
+        {
+        }
+    };
+
+    template <typename T, typename E> union raw_union<T, E, false>
+    {
+        unsigned char none_;
+        T ok_;
+        E err_;
+
+        constexpr raw_union() noexcept : none_{} {}
+
+        template <typename... Args>
+        constexpr explicit raw_union(std::in_place_index_t<ResultKind::Ok>, Args &&...args)
+            : ok_(std::forward<Args>(args)...)
+        {
+        }
+        template <typename... Args>
+        constexpr explicit raw_union(std::in_place_index_t<ResultKind::Err>, Args &&...args)
+            : err_(std::forward<Args>(args)...)
+        {
+        }
+
+        template <typename F, typename... Args>
+        constexpr explicit raw_union(from_invoke_t<ResultKind::Ok>, F &&f, Args &&...args)
+            : ok_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
+        {
+        }
+        template <typename F, typename... Args>
+        constexpr explicit raw_union(from_invoke_t<ResultKind::Err>, F &&f, Args &&...args)
+            : err_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
+        {
+        }
+
+        // the owning storage destroys the active member
+        ~raw_union() {}
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    // tagged union with accessors, special members are layered on top
+    /////////////////////////////////////////////////////////////////////////
+
+    template <typename T, typename E> struct storage_data
+    {
+        raw_union<T, E> union_;
+        ResultKind kind_;
+
+        // leaves the union without an active member, only used by the
+        // copy/move layers right before `construct_from`; `Empty` until it
+        // succeeds, so a throwing copy destroys nothing
+        constexpr storage_data() noexcept : union_{}, kind_{ResultKind::Empty} {}
+
+        template <typename... Args>
+        constexpr explicit storage_data(std::in_place_index_t<ResultKind::Ok> tag, Args &&...args)
+            : union_{tag, std::forward<Args>(args)...}, kind_{ResultKind::Ok}
+        {
+        }
+        template <typename... Args>
+        constexpr explicit storage_data(std::in_place_index_t<ResultKind::Err> tag, Args &&...args)
+            : union_{tag, std::forward<Args>(args)...}, kind_{ResultKind::Err}
+        {
+        }
+        template <ResultKind K, typename... Args>
+        constexpr explicit storage_data(from_invoke_t<K> tag, Args &&...args)
+            : union_{tag, std::forward<Args>(args)...}, kind_{K}
+        {
+        }
+
+        [[nodiscard]] constexpr ResultKind kind() const noexcept { return kind_; }
+
+        constexpr T &ok() & noexcept { return union_.ok_; }
+        constexpr const T &ok() const & noexcept { return union_.ok_; }
+        constexpr T &&ok() && noexcept { return std::move(union_.ok_); }
+        constexpr const T &&ok() const && noexcept { return std::move(union_.ok_); }
+
+        constexpr E &err() & noexcept { return union_.err_; }
+        constexpr const E &err() const & noexcept { return union_.err_; }
+        constexpr E &&err() && noexcept { return std::move(union_.err_); }
+        constexpr const E &&err() const && noexcept { return std::move(union_.err_); }
+
+        constexpr void reset() noexcept
+        {
+            if constexpr (!trivially_destructible<T, E>)
+            {
+                if (kind_ == ResultKind::Ok)
+                {
+                    union_.ok_.~T();
+                }
+                else if (kind_ == ResultKind::Err)
+                {
+                    union_.err_.~E();
+                }
+            }
+        }
+
+        template <ResultKind K, typename... Args> void construct(Args &&...args)
+        {
+            if constexpr (K == ResultKind::Ok)
+            {
+                ::new (static_cast<void *>(&union_.ok_)) T(std::forward<Args>(args)...);
+            }
+            else
+            {
+                ::new (static_cast<void *>(&union_.err_)) E(std::forward<Args>(args)...);
+            }
+            kind_ = K;
+        }
+
+        template <typename Other> void construct_from(Other &&other)
+        {
+            if (other.kind_ == ResultKind::Ok)
+            {
+                construct<ResultKind::Ok>(std::forward<Other>(other).ok());
+            }
+            else
+            {
+                construct<ResultKind::Err>(std::forward<Other>(other).err());
+            }
+        }
+
+        template <ResultKind K, typename... Args> void emplace(Args &&...args)
+        {
+            using Vt = std::conditional_t<K == ResultKind::Ok, T, E>;
+            if constexpr (std::is_nothrow_constructible_v<Vt, Args &&...>)
+            {
+                reset();
+                construct<K>(std::forward<Args>(args)...);
+            }
+            else
+            {
+                // build first so a throwing constructor leaves `*this` untouched
+                Vt tmp(std::forward<Args>(args)...);
+                reset();
+                construct<K>(std::move(tmp));
+            }
+        }
+
+        template <typename Other> void assign_from(Other &&other)
+        {
+            if (kind_ == other.kind_)
+            {
+                if (kind_ == ResultKind::Ok)
+                {
+                    union_.ok_ = std::forward<Other>(other).ok();
+                }
+                else
+                {
+                    union_.err_ = std::forward<Other>(other).err();
+                }
+            }
+            else if (other.kind_ == ResultKind::Ok)
+            {
+                emplace<ResultKind::Ok>(std::forward<Other>(other).ok());
+            }
+            else
+            {
+                emplace<ResultKind::Err>(std::forward<Other>(other).err());
+            }
+        }
+    };
+
+    template <typename T, typename E, bool = trivially_destructible<T, E>> struct storage_dtor : storage_data<T, E>
+    {
+        using storage_data<T, E>::storage_data;
+    };
+
+    template <typename T, typename E> struct storage_dtor<T, E, false> : storage_data<T, E>
+    {
+        using storage_data<T, E>::storage_data;
+
+        storage_dtor()                                = default;
+        storage_dtor(storage_dtor const &)            = default;
+        storage_dtor(storage_dtor &&)                 = default;
+        storage_dtor &operator=(storage_dtor const &) = default;
+        storage_dtor &operator=(storage_dtor &&)      = default;
+        ~storage_dtor() { this->reset(); }
+    };
+
+    template <typename T, typename E,
+              special_member = select_special_member<trivially_copy_constructible<T, E>, copy_constructible<T, E>>>
+    struct storage_copy : storage_dtor<T, E>
+    {
+        using storage_dtor<T, E>::storage_dtor;
+    };
+
+    template <typename T, typename E>
+    struct storage_copy<T, E, special_member::user_defined> : storage_dtor<T, E>
+    {
+        using storage_dtor<T, E>::storage_dtor;
+
+        storage_copy() = default;
+        storage_copy(storage_copy const &other) : storage_dtor<T, E>{} { this->construct_from(other); }
+        storage_copy(storage_copy &&)                 = default;
+        storage_copy &operator=(storage_copy const &) = default;
+        storage_copy &operator=(storage_copy &&)      = default;
+    };
+
+    template <typename T, typename E> struct storage_copy<T, E, special_member::deleted> : storage_dtor<T, E>
+    {
+        using storage_dtor<T, E>::storage_dtor;
+
+        storage_copy()                                = default;
+        storage_copy(storage_copy const &)            = delete;
+        storage_copy(storage_copy &&)                 = default;
+        storage_copy &operator=(storage_copy const &) = default;
+        storage_copy &operator=(storage_copy &&)      = default;
+    };
+
+    // `T` and `E` are required to be nothrow move constructible, so moving is never deleted
+    template <typename T, typename E, bool = trivially_move_constructible<T, E>>
+    struct storage_move : storage_copy<T, E>
+    {
+        using storage_copy<T, E>::storage_copy;
+    };
+
+    template <typename T, typename E> struct storage_move<T, E, false> : storage_copy<T, E>
+    {
+        using storage_copy<T, E>::storage_copy;
+
+        storage_move()                     = default;
+        storage_move(storage_move const &) = default;
+        storage_move(storage_move &&other) noexcept : storage_copy<T, E>{} { this->construct_from(std::move(other)); }
+        storage_move &operator=(storage_move const &) = default;
+        storage_move &operator=(storage_move &&)      = default;
+    };
+
+    template <typename T, typename E,
+              special_member = select_special_member<trivially_copy_assignable<T, E>, copy_assignable<T, E>>>
+    struct storage_copy_assign : storage_move<T, E>
+    {
+        using storage_move<T, E>::storage_move;
+    };
+
+    template <typename T, typename E>
+    struct storage_copy_assign<T, E, special_member::user_defined> : storage_move<T, E>
+    {
+        using storage_move<T, E>::storage_move;
+
+        storage_copy_assign()                            = default;
+        storage_copy_assign(storage_copy_assign const &) = default;
+        storage_copy_assign(storage_copy_assign &&)      = default;
+        storage_copy_assign &operator=(storage_copy_assign const &other)
+        {
+            if (this != &other)
+            {
+                this->assign_from(other);
+            }
+            return *this;
+        }
+        storage_copy_assign &operator=(storage_copy_assign &&) = default;
+    };
+
+    template <typename T, typename E> struct storage_copy_assign<T, E, special_member::deleted> : storage_move<T, E>
+    {
+        using storage_move<T, E>::storage_move;
+
+        storage_copy_assign()                                       = default;
+        storage_copy_assign(storage_copy_assign const &)            = default;
+        storage_copy_assign(storage_copy_assign &&)                 = default;
+        storage_copy_assign &operator=(storage_copy_assign const &) = delete;
+        storage_copy_assign &operator=(storage_copy_assign &&)      = default;
+    };
+
+    template <typename T, typename E, bool = trivially_move_assignable<T, E>>
+    struct storage_move_assign : storage_copy_assign<T, E>
+    {
+        using storage_copy_assign<T, E>::storage_copy_assign;
+    };
+
+    template <typename T, typename E> struct storage_move_assign<T, E, false> : storage_copy_assign<T, E>
+    {
+        using storage_copy_assign<T, E>::storage_copy_assign;
+
+        storage_move_assign()                                       = default;
+        storage_move_assign(storage_move_assign const &)            = default;
+        storage_move_assign(storage_move_assign &&)                 = default;
+        storage_move_assign &operator=(storage_move_assign const &) = default;
+        storage_move_assign &operator=(storage_move_assign &&other) noexcept
+        {
+            if (this != &other)
+            {
+                this->assign_from(std::move(other));
+            }
+            return *this;
+        }
+    };
+
+    // Tagged union backing `Result<T, E>`.
+    //
+    // Unlike `std::variant` every special member is trivial whenever it is
+    // trivial for both `T` and `E`, so e.g. `Result<int, int>` is trivially
+    // copyable and gets returned in registers on the SysV ABI.
+    template <typename T, typename E> struct tagged_storage : storage_move_assign<T, E>
+    {
+        using storage_move_assign<T, E>::storage_move_assign;
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    // niche layout, see `niche_traits`
+    /////////////////////////////////////////////////////////////////////////
+
+    template <typename T> constexpr bool has_niche = niche_traits<T>::available;
+
+    // types that can live in an empty base without any bookkeeping
+    template <typename T>
+    constexpr bool stateless = std::is_empty_v<T> && !std::is_final_v<T> && std::is_trivially_copyable_v<T> &&
+                               std::is_trivially_default_constructible_v<T>;
+
+    template <typename From, typename To>
+    using forward_like_t = std::conditional_t<std::is_lvalue_reference_v<From>,
+                                              std::conditional_t<std::is_const_v<std::remove_reference_t<From>>,
+                                                                 const To &, To &>,
+                                              std::conditional_t<std::is_const_v<std::remove_reference_t<From>>,
+                                                                 const To &&, To &&>>;
+
+    // `full_type` carries the payload and encodes the discriminant in its
+    // niche, `empty_type` is the stateless other side kept as an empty base.
+    // Every special member is the implicit one of `full_type`.
+    template <typename T, typename E, ResultKind FullKind>
+    struct niche_storage : private std::conditional_t<FullKind == ResultKind::Ok, E, T>
+    {
+        using full_type  = std::conditional_t<FullKind == ResultKind::Ok, T, E>;
+        using empty_type = std::conditional_t<FullKind == ResultKind::Ok, E, T>;
+        using traits     = niche_traits<full_type>;
+
+        static constexpr ResultKind EmptyKind = FullKind == ResultKind::Ok ? ResultKind::Err : ResultKind::Ok;
+
+        full_type full_;
+
+        template <typename... Args>
+        constexpr explicit niche_storage(std::in_place_index_t<FullKind>, Args &&...args)
+            : empty_type{}, full_(std::forward<Args>(args)...)
+        {
+        }
+        template <typename... Args>
+        constexpr explicit niche_storage(std::in_place_index_t<EmptyKind>, Args &&...args)
+            : empty_type(std::forward<Args>(args)...), full_(traits::niche())
+        {
+        }
+        template <typename F, typename... Args>
+        constexpr explicit niche_storage(from_invoke_t<FullKind>, F &&f, Args &&...args)
+            : empty_type{}, full_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
+        {
+        }
+        template <typename F, typename... Args>
+        constexpr explicit niche_storage(from_invoke_t<EmptyKind>, F &&f, Args &&...args)
+            : empty_type(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)), full_(traits::niche())
+        {
+        }
+
+        [[nodiscard]] constexpr ResultKind kind() const noexcept
+        {
+            return traits::is_niche(full_) ? EmptyKind : FullKind;
+        }
+
+        constexpr T &ok() & noexcept { return select<ResultKind::Ok>(*this); }
+        constexpr const T &ok() const & noexcept { return select<ResultKind::Ok>(*this); }
+        constexpr T &&ok() && noexcept { return select<ResultKind::Ok>(std::move(*this)); }
+        constexpr const T &&ok() const && noexcept { return select<ResultKind::Ok>(std::move(*this)); }
+
+        constexpr E &err() & noexcept { return select<ResultKind::Err>(*this); }
+        constexpr const E &err() const & noexcept { return select<ResultKind::Err>(*this); }
+        constexpr E &&err() && noexcept { return select<ResultKind::Err>(std::move(*this)); }
+        constexpr const E &&err() const && noexcept { return select<ResultKind::Err>(std::move(*this)); }
+
+        template <ResultKind K, typename... Args> void emplace(Args &&...args)
+        {
+            if constexpr (K == FullKind)
+            {
+                if constexpr (std::is_nothrow_constructible_v<full_type, Args &&...>)
+                {
+                    rebuild_full(std::forward<Args>(args)...);
+                }
+                else
+                {
+                    // build first so a throwing constructor leaves `*this` untouched
+                    full_type tmp(std::forward<Args>(args)...);
+                    rebuild_full(std::move(tmp));
+                }
+            }
+            else
+            {
+                // stateless, nothing to construct in place
+                static_cast<empty_type &>(*this) = empty_type(std::forward<Args>(args)...);
+                rebuild_full(traits::niche());
+            }
+        }
+
+    private:
+        // `full_` always holds a `full_type`, the niche value included
+        template <typename... Args> void rebuild_full(Args &&...args)
+        {
+            full_.~full_type();
+            ::new (static_cast<void *>(&full_)) full_type(std::forward<Args>(args)...);
+        }
+
+        template <ResultKind K, typename Self> static constexpr auto &&select(Self &&self) noexcept
+        {
+            if constexpr (K == FullKind)
+            {
+                return std::forward<Self>(self).full_;
+            }
+            else
+            {
+                return static_cast<forward_like_t<Self &&, empty_type>>(self);
+            }
+        }
+    };
+
+    // picks the niche layout when one side can encode the discriminant and
+    // the other side has no state, the tagged union otherwise
+    template <typename T, typename E>
+    using storage = std::conditional_t<has_niche<T> && stateless<E>, niche_storage<T, E, ResultKind::Ok>,
+                                       std::conditional_t<has_niche<E> && stateless<T>,
+                                                          niche_storage<T, E, ResultKind::Err>, tagged_storage<T, E>>>;
+} // namespace result_type::detail
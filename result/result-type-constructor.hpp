@@ -1,5 +1,7 @@
 #pragma once
 #include "result-helper.hpp"
+#include <cstddef>
+#include <tuple>
 #include <utility>
 
 namespace result_type
@@ -43,4 +45,65 @@ namespace result_type
     };
     template <typename = void> Ok() -> Ok<void>;
     template <typename T> Ok(T) -> Ok<T>;
+
+    /////////////////////////////////////////////////////////////////////////
+    // in-place construction
+    /////////////////////////////////////////////////////////////////////////
+
+    // tags selecting the alternative a `Result` constructs in place
+    struct in_place_ok_t
+    {
+        explicit in_place_ok_t() = default;
+    };
+    struct in_place_err_t
+    {
+        explicit in_place_err_t() = default;
+    };
+    inline constexpr in_place_ok_t in_place_ok{};
+    inline constexpr in_place_err_t in_place_err{};
+
+    // Lazy counterparts of `Ok` and `Err`. They only hold references to the
+    // constructor arguments and build the value straight inside the `Result`
+    // they are converted to, so large or immovable payloads are never
+    // constructed twice. Being reference wrappers they must not outlive the
+    // full expression, use them through `ok_in_place` / `err_in_place`.
+    template <typename Tag, typename... Args> class [[nodiscard]] InPlace
+    {
+    public:
+        explicit constexpr InPlace(Args &&...args) : args_{std::forward<Args>(args)...} {}
+
+        template <typename T, typename E> constexpr operator Result<T, E>() &&
+        {
+            return build<T, E>(std::index_sequence_for<Args...>{});
+        }
+
+    private:
+        template <typename T, typename E, std::size_t... I>
+        constexpr Result<T, E> build(std::index_sequence<I...>)
+        {
+            return Result<T, E>(Tag{}, std::get<I>(std::move(args_))...);
+        }
+
+        std::tuple<Args &&...> args_;
+    };
+
+    template <typename... Args> using InPlaceOk  = InPlace<in_place_ok_t, Args...>;
+    template <typename... Args> using InPlaceErr = InPlace<in_place_err_t, Args...>;
+
+    /// Basic usage:
+    ///
+    /// ``` cpp
+    /// // `Message(header, 4096)` is constructed directly in the returned `Result`
+    /// auto read() -> Result<Message, string>
+    /// {
+    ///     return ok_in_place(header, 4096);
+    /// }
+    template <typename... Args> constexpr auto ok_in_place(Args &&...args) -> InPlaceOk<Args...>
+    {
+        return InPlaceOk<Args...>(std::forward<Args>(args)...);
+    }
+    template <typename... Args> constexpr auto err_in_place(Args &&...args) -> InPlaceErr<Args...>
+    {
+        return InPlaceErr<Args...>(std::forward<Args>(args)...);
+    }
 } // namespace result_type
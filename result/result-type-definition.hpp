@@ -1,17 +1,8 @@
 #pragma once
 #include "result-helper.hpp"
 #include "result-type-constructor.hpp"
+#include "result-storage.hpp"
 #include <utility>
-#include <variant>
-
-namespace result_type::detail
-{
-    enum ResultKind : std::size_t
-    {
-        Ok = 0,
-        Err,
-    };
-}
 
 namespace result_type
 {
@@ -21,33 +12,66 @@ namespace result_type
     public:
         using value_type = T;
         using error_type = E;
-        using storage    = std::variant<T, E>;
+        using storage    = detail::storage<T, E>;
 
     private:
-        storage result_variant_;
+        storage result_storage_;
+
+        template <typename Tp, typename Er> friend class Result;
+
+        // builds alternative `K` from `std::invoke(f, args...)` without an intermediate move
+        template <detail::ResultKind K, typename F, typename... Args>
+        constexpr Result(detail::from_invoke_t<K> tag, F &&f, Args &&...args)
+            : result_storage_{tag, std::forward<F>(f), std::forward<Args>(args)...}
+        {
+        }
 
     public:
         // constructors of result type
         constexpr Result(Ok<T> &&ok)
-            : result_variant_{std::in_place_index<detail::ResultKind::Ok>, std::move(ok.value_)}
+            : result_storage_{std::in_place_index<detail::ResultKind::Ok>, std::move(ok.value_)}
         {
         }
         constexpr Result(Err<E> &&err)
-            : result_variant_{std::in_place_index<detail::ResultKind::Err>, std::move(err.value_)}
+            : result_storage_{std::in_place_index<detail::ResultKind::Err>, std::move(err.value_)}
         {
         }
 
         constexpr Result &operator=(Ok<T> &&other)
         {
-            result_variant_.template emplace<detail::ResultKind::Ok>(std::move(other.value_));
+            result_storage_.template emplace<detail::ResultKind::Ok>(std::move(other.value_));
             return *this;
         }
         constexpr Result &operator=(Err<E> &&other)
         {
-            result_variant_.template emplace<detail::ResultKind::Err>(std::move(other.value_));
+            result_storage_.template emplace<detail::ResultKind::Err>(std::move(other.value_));
             return *this;
         }
 
+        // construct the `Ok` / `Err` value in place from `args`
+        template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args &&...>>>
+        constexpr explicit Result(in_place_ok_t, Args &&...args)
+            : result_storage_{std::in_place_index<detail::ResultKind::Ok>, std::forward<Args>(args)...}
+        {
+        }
+        template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<E, Args &&...>>>
+        constexpr explicit Result(in_place_err_t, Args &&...args)
+            : result_storage_{std::in_place_index<detail::ResultKind::Err>, std::forward<Args>(args)...}
+        {
+        }
+
+        // destroy the contained value and construct a new `Ok` / `Err` value in place
+        template <typename... Args> constexpr T &emplace_ok(Args &&...args)
+        {
+            result_storage_.template emplace<detail::ResultKind::Ok>(std::forward<Args>(args)...);
+            return result_storage_.ok();
+        }
+        template <typename... Args> constexpr E &emplace_err(Args &&...args)
+        {
+            result_storage_.template emplace<detail::ResultKind::Err>(std::forward<Args>(args)...);
+            return result_storage_.err();
+        }
+
         constexpr Result(Result &&)                      = default;
         constexpr Result &operator=(Result &&)           = default;
         constexpr Result(Result const &other)            = default;
@@ -126,20 +150,20 @@ namespace result_type
         /////////////////////////////////////////////////////////////////////////
 
         // call fn `f` on `Ok` type if it exists, return Result<T, E> from `f(T)` or `Err(E)`
-        template <typename F> constexpr auto and_then(F &&f) & -> helper::monadic_enable_t<E, F, E &, T &>;
+        template <typename F> constexpr auto and_then(F &&f) & RESULT_ENABLE_MONADIC(E, F, E &, T &);
         template <typename F>
-        constexpr auto and_then(F &&f) const & -> helper::monadic_enable_t<E, F, const E &, const T &>;
-        template <typename F> constexpr auto and_then(F &&f) && -> helper::monadic_enable_t<E, F, E, T &&>;
+        constexpr auto and_then(F &&f) const & RESULT_ENABLE_MONADIC(E, F, const E &, const T &);
+        template <typename F> constexpr auto and_then(F &&f) && RESULT_ENABLE_MONADIC(E, F, E, T &&);
         template <typename F>
-        constexpr auto and_then(F &&f) const && -> helper::monadic_enable_t<E, F, const E, const T &&>;
+        constexpr auto and_then(F &&f) const && RESULT_ENABLE_MONADIC(E, F, const E, const T &&);
 
         // call fn `f` on `Err` type if it exists, return Result<T, E> from `f(E)` or `Ok(T)`
-        template <typename F> constexpr auto or_else(F &&f) & -> helper::monadic_enable_t<T, F, T &, E &>;
+        template <typename F> constexpr auto or_else(F &&f) & RESULT_ENABLE_MONADIC(T, F, T &, E &);
         template <typename F>
-        constexpr auto or_else(F &&f) const & -> helper::monadic_enable_t<T, F, const T &, const E &>;
-        template <typename F> constexpr auto or_else(F &&f) && -> helper::monadic_enable_t<T, F, T, E &&>;
+        constexpr auto or_else(F &&f) const & RESULT_ENABLE_MONADIC(T, F, const T &, const E &);
+        template <typename F> constexpr auto or_else(F &&f) && RESULT_ENABLE_MONADIC(T, F, T, E &&);
         template <typename F>
-        constexpr auto or_else(F &&f) const && -> helper::monadic_enable_t<T, F, const T, const E &&>;
+        constexpr auto or_else(F &&f) const && RESULT_ENABLE_MONADIC(T, F, const T, const E &&);
 
         /////////////////////////////////////////////////////////////////////////
         // Transforming contained values
@@ -147,20 +171,20 @@ namespace result_type
 
         // Maps a `Result<T, E>` to `Result<U, E>` by applying a function `f(T) -> U` to a
         // contained [`Ok`] value, leaving an [`Err`] value untouched.
-        template <typename F> constexpr auto map(F &&f) & -> helper::transform_enable_t<E, F, E &, T &>;
+        template <typename F> constexpr auto map(F &&f) & RESULT_ENABLE_TRANSFORM(E, F, E &, T &);
         template <typename F>
-        constexpr auto map(F &&f) const & -> helper::transform_enable_t<E, F, const E &, const T &>;
-        template <typename F> constexpr auto map(F &&f) && -> helper::transform_enable_t<E, F, E, T>;
-        template <typename F> constexpr auto map(F &&f) const && -> helper::transform_enable_t<E, F, const E, const T>;
+        constexpr auto map(F &&f) const & RESULT_ENABLE_TRANSFORM(E, F, const E &, const T &);
+        template <typename F> constexpr auto map(F &&f) && RESULT_ENABLE_TRANSFORM(E, F, E, T);
+        template <typename F> constexpr auto map(F &&f) const && RESULT_ENABLE_TRANSFORM(E, F, const E, const T);
 
         // Maps a `Result<T, E>` to `Result<T, G>` by applying a function `f(E) -> G` to a
         // contained [`Err`] value, leaving an [`Ok`] value untouched.
-        template <typename F> constexpr auto map_err(F &&f) & -> helper::transform_err_enable_t<T, F, T &, E &>;
+        template <typename F> constexpr auto map_err(F &&f) & RESULT_ENABLE_TRANSFORM_ERR(T, F, T &, E &);
         template <typename F>
-        constexpr auto map_err(F &&f) const & -> helper::transform_err_enable_t<T, F, const T &, const E &>;
-        template <typename F> constexpr auto map_err(F &&f) && -> helper::transform_err_enable_t<T, F, T, E &&>;
+        constexpr auto map_err(F &&f) const & RESULT_ENABLE_TRANSFORM_ERR(T, F, const T &, const E &);
+        template <typename F> constexpr auto map_err(F &&f) && RESULT_ENABLE_TRANSFORM_ERR(T, F, T, E &&);
         template <typename F>
-        constexpr auto map_err(F &&f) const && -> helper::transform_err_enable_t<T, F, const T, const E &&>;
+        constexpr auto map_err(F &&f) const && RESULT_ENABLE_TRANSFORM_ERR(T, F, const T, const E &&);
     };
 
     /////////////////////////////////////////////////////////////////////////
@@ -172,32 +196,57 @@ namespace result_type
     public:
         using value_type = void;
         using error_type = E;
-        using storage    = std::variant<std::monostate, E>;
+        using storage    = detail::storage<detail::unit, E>;
 
     private:
-        storage result_variant_;
+        storage result_storage_;
+
+        template <typename Tp, typename Er> friend class Result;
+
+        // builds alternative `K` from `std::invoke(f, args...)` without an intermediate move
+        template <detail::ResultKind K, typename F, typename... Args>
+        constexpr Result(detail::from_invoke_t<K> tag, F &&f, Args &&...args)
+            : result_storage_{tag, std::forward<F>(f), std::forward<Args>(args)...}
+        {
+        }
 
     public:
         // constructors of result type
-        constexpr Result(Ok<void> &&) : result_variant_{std::in_place_index<detail::ResultKind::Ok>, std::monostate{}}
+        constexpr Result(Ok<void> &&) : result_storage_{std::in_place_index<detail::ResultKind::Ok>}
         {
         }
         constexpr Result(Err<E> &&err)
-            : result_variant_{std::in_place_index<detail::ResultKind::Err>, std::move(err.value_)}
+            : result_storage_{std::in_place_index<detail::ResultKind::Err>, std::move(err.value_)}
         {
         }
 
         constexpr Result &operator=(Ok<void> &&)
         {
-            result_variant_.template emplace<detail::ResultKind::Ok>(std::monostate{});
+            result_storage_.template emplace<detail::ResultKind::Ok>();
             return *this;
         }
         constexpr Result &operator=(Err<E> &&other)
         {
-            result_variant_.template emplace<detail::ResultKind::Err>(std::move(other.value_));
+            result_storage_.template emplace<detail::ResultKind::Err>(std::move(other.value_));
             return *this;
         }
 
+        // construct the `Ok` / `Err` value in place from `args`
+        constexpr explicit Result(in_place_ok_t) : result_storage_{std::in_place_index<detail::ResultKind::Ok>} {}
+        template <typename... Args, typename = std::enable_if_t<std::is_constructible_v<E, Args &&...>>>
+        constexpr explicit Result(in_place_err_t, Args &&...args)
+            : result_storage_{std::in_place_index<detail::ResultKind::Err>, std::forward<Args>(args)...}
+        {
+        }
+
+        // destroy the contained error (if any) and become `Ok` / construct a new `Err` value in place
+        constexpr void emplace_ok() { result_storage_.template emplace<detail::ResultKind::Ok>(); }
+        template <typename... Args> constexpr E &emplace_err(Args &&...args)
+        {
+            result_storage_.template emplace<detail::ResultKind::Err>(std::forward<Args>(args)...);
+            return result_storage_.err();
+        }
+
         constexpr Result(Result &&)                      = default;
         constexpr Result &operator=(Result &&)           = default;
         constexpr Result(Result const &other)            = default;
@@ -251,17 +300,17 @@ namespace result_type
         /////////////////////////////////////////////////////////////////////////
 
         // call fn `f` on `Ok` type if it exists, return Result<T, E> from `f(T)` or `Err(E)`
-        template <typename F> constexpr auto and_then(F &&f) & -> helper::monadic_no_arg_enable_t<E, F, E &>;
+        template <typename F> constexpr auto and_then(F &&f) & RESULT_ENABLE_MONADIC_NO_ARG(E, F, E &);
         template <typename F>
-        constexpr auto and_then(F &&f) const & -> helper::monadic_no_arg_enable_t<E, F, const E &>;
-        template <typename F> constexpr auto and_then(F &&f) && -> helper::monadic_no_arg_enable_t<E, F, E>;
-        template <typename F> constexpr auto and_then(F &&f) const && -> helper::monadic_no_arg_enable_t<E, F, const E>;
+        constexpr auto and_then(F &&f) const & RESULT_ENABLE_MONADIC_NO_ARG(E, F, const E &);
+        template <typename F> constexpr auto and_then(F &&f) && RESULT_ENABLE_MONADIC_NO_ARG(E, F, E);
+        template <typename F> constexpr auto and_then(F &&f) const && RESULT_ENABLE_MONADIC_NO_ARG(E, F, const E);
 
         // call fn `f` on `Err` type if it exists, return Result<T, E> from `f(E)` or `Ok(T)`
-        template <typename F> constexpr auto or_else(F &&f) & -> helper::fn_eval_result<F, E &>;
-        template <typename F> constexpr auto or_else(F &&f) const & -> helper::fn_eval_result<F, const E &>;
-        template <typename F> constexpr auto or_else(F &&f) && -> helper::fn_eval_result<F, E &&>;
-        template <typename F> constexpr auto or_else(F &&f) const && -> helper::fn_eval_result<F, const E &&>;
+        template <typename F> constexpr auto or_else(F &&f) & RESULT_ENABLE_INVOKE(F, E &);
+        template <typename F> constexpr auto or_else(F &&f) const & RESULT_ENABLE_INVOKE(F, const E &);
+        template <typename F> constexpr auto or_else(F &&f) && RESULT_ENABLE_INVOKE(F, E &&);
+        template <typename F> constexpr auto or_else(F &&f) const && RESULT_ENABLE_INVOKE(F, const E &&);
 
         /////////////////////////////////////////////////////////////////////////
         // Transforming contained values
@@ -269,19 +318,19 @@ namespace result_type
 
         // Maps a `Result<T, E>` to `Result<U, E>` by applying a function `f(T) -> U` to a
         // contained [`Ok`] value, leaving an [`Err`] value untouched.
-        template <typename F> constexpr auto map(F &&f) & -> helper::transform_no_arg_enable_t<E, F, E &>;
-        template <typename F> constexpr auto map(F &&f) const & -> helper::transform_no_arg_enable_t<E, F, const E &>;
-        template <typename F> constexpr auto map(F &&f) && -> helper::transform_no_arg_enable_t<E, F, E>;
-        template <typename F> constexpr auto map(F &&f) const && -> helper::transform_no_arg_enable_t<E, F, const E>;
+        template <typename F> constexpr auto map(F &&f) & RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, E &);
+        template <typename F> constexpr auto map(F &&f) const & RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, const E &);
+        template <typename F> constexpr auto map(F &&f) && RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, E);
+        template <typename F> constexpr auto map(F &&f) const && RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, const E);
 
         // Maps a `Result<T, E>` to `Result<T, G>` by applying a function `f(E) -> G` to a
         // contained [`Err`] value, leaving an [`Ok`] value untouched.
-        template <typename F> constexpr auto map_err(F &&f) & -> Result<void, helper::fn_eval_result_xform<F, E &>>;
+        template <typename F> constexpr auto map_err(F &&f) & RESULT_ENABLE_TRANSFORM_ERR_VOID(F, E &);
         template <typename F>
-        constexpr auto map_err(F &&f) const & -> Result<void, helper::fn_eval_result_xform<F, const E &>>;
-        template <typename F> constexpr auto map_err(F &&f) && -> Result<void, helper::fn_eval_result_xform<F, E &&>>;
+        constexpr auto map_err(F &&f) const & RESULT_ENABLE_TRANSFORM_ERR_VOID(F, const E &);
+        template <typename F> constexpr auto map_err(F &&f) && RESULT_ENABLE_TRANSFORM_ERR_VOID(F, E &&);
         template <typename F>
-        constexpr auto map_err(F &&f) const && -> Result<void, helper::fn_eval_result_xform<F, const E &&>>;
+        constexpr auto map_err(F &&f) const && RESULT_ENABLE_TRANSFORM_ERR_VOID(F, const E &&);
     };
 
     /// Basic usage:
@@ -297,10 +346,16 @@ namespace result_type
     /// auto c = make_ok<int, string>(9); // 'c' = Result<string, int>
     template <typename T, typename E> constexpr auto make_ok(T &&value) -> Result<T, E>
     {
-        return Ok<T>(std::forward<T>(value));
+        return Result<T, E>(in_place_ok, std::move(value));
+    }
+    template <typename T, typename E> constexpr auto make_ok(const T &value) -> Result<T, E>
+    {
+        return Result<T, E>(in_place_ok, value);
+    }
+    template <typename = void, typename E> constexpr auto make_ok() -> Result<void, E>
+    {
+        return Result<void, E>(in_place_ok);
     }
-    template <typename T, typename E> constexpr auto make_ok(const T &value) -> Result<T, E> { return Ok<T>(value); }
-    template <typename = void, typename E> constexpr auto make_ok() -> Result<void, E> { return Ok<void>(); }
 
     /// Basic usage:
     ///
@@ -316,7 +371,10 @@ namespace result_type
     /// auto c = make_err<int, string>("bar"s); // 'c' = Result<int, string>
     template <typename T, typename E> constexpr auto make_err(E &&err) -> Result<T, E>
     {
-        return Err<E>(std::forward<E>(err));
+        return Result<T, E>(in_place_err, std::move(err));
+    }
+    template <typename T, typename E> constexpr auto make_err(const E &err) -> Result<T, E>
+    {
+        return Result<T, E>(in_place_err, err);
     }
-    template <typename T, typename E> constexpr auto make_err(const E &err) -> Result<T, E> { return Err<E>(err); }
 } // namespace result_type
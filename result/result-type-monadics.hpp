@@ -7,7 +7,7 @@ namespace result_type
 {
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::and_then(F &&f) & -> helper::monadic_enable_t<E, F, E &, T &>
+    constexpr auto Result<T, E>::and_then(F &&f) & RESULT_ENABLE_MONADIC(E, F, E &, T &)
     {
         using U = helper::fn_eval_result<F, T &>;
 
@@ -16,17 +16,16 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.ok());
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<typename U::value_type, typename U::error_type>(result_storage_.err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::and_then(F &&f) const & -> helper::monadic_enable_t<E, F, const E &, const T &>
+    constexpr auto Result<T, E>::and_then(F &&f) const & RESULT_ENABLE_MONADIC(E, F, const E &, const T &)
     {
         using U = helper::fn_eval_result<F, const T &>;
 
@@ -35,17 +34,16 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.ok());
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<typename U::value_type, typename U::error_type>(result_storage_.err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::and_then(F &&f) && -> helper::monadic_enable_t<E, F, E, T &&>
+    constexpr auto Result<T, E>::and_then(F &&f) && RESULT_ENABLE_MONADIC(E, F, E, T &&)
     {
         using U = helper::fn_eval_result<F, T &&>;
 
@@ -54,17 +52,16 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).ok());
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<typename U::value_type, typename U::error_type>(std::move(result_storage_).err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::and_then(F &&f) const && -> helper::monadic_enable_t<E, F, const E, const T &&>
+    constexpr auto Result<T, E>::and_then(F &&f) const && RESULT_ENABLE_MONADIC(E, F, const E, const T &&)
     {
         using U = helper::fn_eval_result<F, const T &&>;
 
@@ -73,18 +70,17 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).ok());
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<typename U::value_type, typename U::error_type>(std::move(result_storage_).err());
         }
     }
 
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::or_else(F &&f) & -> helper::monadic_enable_t<T, F, T &, E &>
+    constexpr auto Result<T, E>::or_else(F &&f) & RESULT_ENABLE_MONADIC(T, F, T &, E &)
     {
         using G = helper::fn_eval_result<F, E &>;
 
@@ -93,17 +89,16 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         else
         {
-            return make_ok<typename G::value_type, typename G::error_type>(
-                std::get<detail::ResultKind::Ok>(result_variant_));
+            return make_ok<typename G::value_type, typename G::error_type>(result_storage_.ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::or_else(F &&f) const & -> helper::monadic_enable_t<T, F, const T &, const E &>
+    constexpr auto Result<T, E>::or_else(F &&f) const & RESULT_ENABLE_MONADIC(T, F, const T &, const E &)
     {
         using G = helper::fn_eval_result<F, const E &>;
 
@@ -112,17 +107,16 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         else
         {
-            return make_ok<typename G::value_type, typename G::error_type>(
-                std::get<detail::ResultKind::Ok>(result_variant_));
+            return make_ok<typename G::value_type, typename G::error_type>(result_storage_.ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::or_else(F &&f) && -> helper::monadic_enable_t<T, F, T, E &&>
+    constexpr auto Result<T, E>::or_else(F &&f) && RESULT_ENABLE_MONADIC(T, F, T, E &&)
     {
         using G = helper::fn_eval_result<F, E &&>;
 
@@ -131,17 +125,16 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         else
         {
-            return make_ok<typename G::value_type, typename G::error_type>(
-                std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return make_ok<typename G::value_type, typename G::error_type>(std::move(result_storage_).ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::or_else(F &&f) const && -> helper::monadic_enable_t<T, F, const T, const E &&>
+    constexpr auto Result<T, E>::or_else(F &&f) const && RESULT_ENABLE_MONADIC(T, F, const T, const E &&)
     {
         using G = helper::fn_eval_result<F, const E &&>;
 
@@ -150,18 +143,17 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         else
         {
-            return make_ok<typename G::value_type, typename G::error_type>(
-                std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return make_ok<typename G::value_type, typename G::error_type>(std::move(result_storage_).ok());
         }
     }
 
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map(F &&f) & -> helper::transform_enable_t<E, F, E &, T &>
+    constexpr auto Result<T, E>::map(F &&f) & RESULT_ENABLE_TRANSFORM(E, F, E &, T &)
     {
         using U = helper::fn_eval_result_xform<F, T &>;
 
@@ -169,23 +161,23 @@ namespace result_type
         {
             if constexpr (std::is_void_v<U>)
             {
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_));
+                std::invoke(std::forward<F>(f), result_storage_.ok());
                 return make_ok<void, E>();
             }
             else
             {
-                return make_ok<U, E>(
-                    std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_)));
+                return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f),
+                                    result_storage_.ok());
             }
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<U, E>(result_storage_.err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map(F &&f) const & -> helper::transform_enable_t<E, F, const E &, const T &>
+    constexpr auto Result<T, E>::map(F &&f) const & RESULT_ENABLE_TRANSFORM(E, F, const E &, const T &)
     {
         using U = helper::fn_eval_result_xform<F, const T &>;
 
@@ -193,23 +185,23 @@ namespace result_type
         {
             if constexpr (std::is_void_v<U>)
             {
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_));
+                std::invoke(std::forward<F>(f), result_storage_.ok());
                 return make_ok<void, E>();
             }
             else
             {
-                return make_ok<U, E>(
-                    std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_)));
+                return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f),
+                                    result_storage_.ok());
             }
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<U, E>(result_storage_.err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map(F &&f) && -> helper::transform_enable_t<E, F, E, T>
+    constexpr auto Result<T, E>::map(F &&f) && RESULT_ENABLE_TRANSFORM(E, F, E, T)
     {
         using U = helper::fn_eval_result_xform<F, T>;
 
@@ -217,23 +209,23 @@ namespace result_type
         {
             if constexpr (std::is_void_v<U>)
             {
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+                std::invoke(std::forward<F>(f), std::move(result_storage_).ok());
                 return make_ok<void, E>();
             }
             else
             {
-                return make_ok<U, E>(
-                    std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_))));
+                return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f),
+                                    std::move(result_storage_).ok());
             }
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<U, E>(std::move(result_storage_).err());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map(F &&f) const && -> helper::transform_enable_t<E, F, const E, const T>
+    constexpr auto Result<T, E>::map(F &&f) const && RESULT_ENABLE_TRANSFORM(E, F, const E, const T)
     {
         using U = helper::fn_eval_result_xform<F, const T>;
 
@@ -241,81 +233,83 @@ namespace result_type
         {
             if constexpr (std::is_void_v<U>)
             {
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+                std::invoke(std::forward<F>(f), std::move(result_storage_).ok());
                 return make_ok<void, E>();
             }
             else
             {
-                return make_ok<U, E>(
-                    std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_))));
+                return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f),
+                                    std::move(result_storage_).ok());
             }
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<U, E>(std::move(result_storage_).err());
         }
     }
 
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map_err(F &&f) & -> helper::transform_err_enable_t<T, F, T &, E &>
+    constexpr auto Result<T, E>::map_err(F &&f) & RESULT_ENABLE_TRANSFORM_ERR(T, F, T &, E &)
     {
         using G = helper::fn_eval_result_xform<F, E &>;
 
         if (is_err())
         {
-            return make_err<T, G>(std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_)));
+            return Result<T, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                result_storage_.err());
         }
         else
         {
-            return make_ok<T, G>(std::get<detail::ResultKind::Ok>(result_variant_));
+            return make_ok<T, G>(result_storage_.ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map_err(F &&f) const & -> helper::transform_err_enable_t<T, F, const T &, const E &>
+    constexpr auto Result<T, E>::map_err(F &&f) const & RESULT_ENABLE_TRANSFORM_ERR(T, F, const T &, const E &)
     {
         using G = helper::fn_eval_result_xform<F, const E &>;
 
         if (is_err())
         {
-            return make_err<T, G>(std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_)));
+            return Result<T, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                result_storage_.err());
         }
         else
         {
-            return make_ok<T, G>(std::get<detail::ResultKind::Ok>(result_variant_));
+            return make_ok<T, G>(result_storage_.ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map_err(F &&f) && -> helper::transform_err_enable_t<T, F, T, E &&>
+    constexpr auto Result<T, E>::map_err(F &&f) && RESULT_ENABLE_TRANSFORM_ERR(T, F, T, E &&)
     {
         using G = helper::fn_eval_result_xform<F, E &&>;
 
         if (is_err())
         {
-            return make_err<T, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_))));
+            return Result<T, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                std::move(result_storage_).err());
         }
         else
         {
-            return make_ok<T, G>(std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return make_ok<T, G>(std::move(result_storage_).ok());
         }
     }
     template <typename T, typename E>
     template <typename F>
-    constexpr auto Result<T, E>::map_err(F &&f) const && -> helper::transform_err_enable_t<T, F, const T, const E &&>
+    constexpr auto Result<T, E>::map_err(F &&f) const && RESULT_ENABLE_TRANSFORM_ERR(T, F, const T, const E &&)
     {
         using G = helper::fn_eval_result_xform<F, const E &&>;
 
         if (is_err())
         {
-            return make_err<T, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_))));
+            return Result<T, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                std::move(result_storage_).err());
         }
         else
         {
-            return make_ok<T, G>(std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return make_ok<T, G>(std::move(result_storage_).ok());
         }
     }
 
@@ -325,7 +319,7 @@ namespace result_type
 
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::and_then(F &&f) & -> helper::monadic_no_arg_enable_t<E, F, E &>
+    constexpr auto Result<void, E>::and_then(F &&f) & RESULT_ENABLE_MONADIC_NO_ARG(E, F, E &)
     {
         using U = helper::fn_eval_result_no_arg<F>;
 
@@ -338,13 +332,12 @@ namespace result_type
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<typename U::value_type, typename U::error_type>(result_storage_.err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::and_then(F &&f) const & -> helper::monadic_no_arg_enable_t<E, F, const E &>
+    constexpr auto Result<void, E>::and_then(F &&f) const & RESULT_ENABLE_MONADIC_NO_ARG(E, F, const E &)
     {
         using U = helper::fn_eval_result_no_arg<F>;
 
@@ -357,13 +350,12 @@ namespace result_type
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<typename U::value_type, typename U::error_type>(result_storage_.err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::and_then(F &&f) && -> helper::monadic_no_arg_enable_t<E, F, E>
+    constexpr auto Result<void, E>::and_then(F &&f) && RESULT_ENABLE_MONADIC_NO_ARG(E, F, E)
     {
         using U = helper::fn_eval_result_no_arg<F>;
 
@@ -376,13 +368,12 @@ namespace result_type
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<typename U::value_type, typename U::error_type>(std::move(result_storage_).err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::and_then(F &&f) const && -> helper::monadic_no_arg_enable_t<E, F, const E>
+    constexpr auto Result<void, E>::and_then(F &&f) const && RESULT_ENABLE_MONADIC_NO_ARG(E, F, const E)
     {
         using U = helper::fn_eval_result_no_arg<F>;
 
@@ -395,14 +386,13 @@ namespace result_type
         }
         else
         {
-            return make_err<typename U::value_type, typename U::error_type>(
-                std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<typename U::value_type, typename U::error_type>(std::move(result_storage_).err());
         }
     }
 
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::or_else(F &&f) & -> helper::fn_eval_result<F, E &>
+    constexpr auto Result<void, E>::or_else(F &&f) & RESULT_ENABLE_INVOKE(F, E &)
     {
         using G = helper::fn_eval_result<F, E &>;
 
@@ -411,7 +401,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         else
         {
@@ -420,7 +410,7 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::or_else(F &&f) const & -> helper::fn_eval_result<F, const E &>
+    constexpr auto Result<void, E>::or_else(F &&f) const & RESULT_ENABLE_INVOKE(F, const E &)
     {
         using G = helper::fn_eval_result<F, const E &>;
 
@@ -429,7 +419,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         else
         {
@@ -438,7 +428,7 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::or_else(F &&f) && -> helper::fn_eval_result<F, E &&>
+    constexpr auto Result<void, E>::or_else(F &&f) && RESULT_ENABLE_INVOKE(F, E &&)
     {
         using G = helper::fn_eval_result<F, E &&>;
 
@@ -447,7 +437,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         else
         {
@@ -456,7 +446,7 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::or_else(F &&f) const && -> helper::fn_eval_result<F, const E &&>
+    constexpr auto Result<void, E>::or_else(F &&f) const && RESULT_ENABLE_INVOKE(F, const E &&)
     {
         using G = helper::fn_eval_result<F, const E &&>;
 
@@ -465,7 +455,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         else
         {
@@ -475,75 +465,75 @@ namespace result_type
 
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map(F &&f) & -> helper::transform_no_arg_enable_t<E, F, E &>
+    constexpr auto Result<void, E>::map(F &&f) & RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, E &)
     {
         using U = helper::fn_eval_result_xform_no_arg<F>;
 
         if (is_ok())
         {
-            return make_ok<U, E>(std::invoke(std::forward<F>(f)));
+            return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f));
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<U, E>(result_storage_.err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map(F &&f) const & -> helper::transform_no_arg_enable_t<E, F, const E &>
+    constexpr auto Result<void, E>::map(F &&f) const & RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, const E &)
     {
         using U = helper::fn_eval_result_xform_no_arg<F>;
 
         if (is_ok())
         {
-            return make_ok<U, E>(std::invoke(std::forward<F>(f)));
+            return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f));
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(result_variant_));
+            return make_err<U, E>(result_storage_.err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map(F &&f) && -> helper::transform_no_arg_enable_t<E, F, E>
+    constexpr auto Result<void, E>::map(F &&f) && RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, E)
     {
         using U = helper::fn_eval_result_xform_no_arg<F>;
 
         if (is_ok())
         {
-            return make_ok<U, E>(std::invoke(std::forward<F>(f)));
+            return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f));
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<U, E>(std::move(result_storage_).err());
         }
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map(F &&f) const && -> helper::transform_no_arg_enable_t<E, F, const E>
+    constexpr auto Result<void, E>::map(F &&f) const && RESULT_ENABLE_TRANSFORM_NO_ARG(E, F, const E)
     {
         using U = helper::fn_eval_result_xform_no_arg<F>;
 
         if (is_ok())
         {
-            return make_ok<U, E>(std::invoke(std::forward<F>(f)));
+            return Result<U, E>(detail::from_invoke<detail::ResultKind::Ok>, std::forward<F>(f));
         }
         else
         {
-            return make_err<U, E>(std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return make_err<U, E>(std::move(result_storage_).err());
         }
     }
 
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map_err(F &&f) & -> Result<void, helper::fn_eval_result_xform<F, E &>>
+    constexpr auto Result<void, E>::map_err(F &&f) & RESULT_ENABLE_TRANSFORM_ERR_VOID(F, E &)
     {
         using G = helper::fn_eval_result_xform<F, E &>;
 
         if (is_err())
         {
-            return make_err<void, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_)));
+            return Result<void, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                   result_storage_.err());
         }
         else
         {
@@ -552,14 +542,14 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map_err(F &&f) const & -> Result<void, helper::fn_eval_result_xform<F, const E &>>
+    constexpr auto Result<void, E>::map_err(F &&f) const & RESULT_ENABLE_TRANSFORM_ERR_VOID(F, const E &)
     {
         using G = helper::fn_eval_result_xform<F, const E &>;
 
         if (is_err())
         {
-            return make_err<void, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_)));
+            return Result<void, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                   result_storage_.err());
         }
         else
         {
@@ -568,14 +558,14 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map_err(F &&f) && -> Result<void, helper::fn_eval_result_xform<F, E &&>>
+    constexpr auto Result<void, E>::map_err(F &&f) && RESULT_ENABLE_TRANSFORM_ERR_VOID(F, E &&)
     {
         using G = helper::fn_eval_result_xform<F, E &&>;
 
         if (is_err())
         {
-            return make_err<void, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_))));
+            return Result<void, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                   std::move(result_storage_).err());
         }
         else
         {
@@ -584,14 +574,14 @@ namespace result_type
     }
     template <typename E>
     template <typename F>
-    constexpr auto Result<void, E>::map_err(F &&f) const && -> Result<void, helper::fn_eval_result_xform<F, const E &&>>
+    constexpr auto Result<void, E>::map_err(F &&f) const && RESULT_ENABLE_TRANSFORM_ERR_VOID(F, const E &&)
     {
         using G = helper::fn_eval_result_xform<F, const E &&>;
 
         if (is_err())
         {
-            return make_err<void, G>(
-                std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_))));
+            return Result<void, G>(detail::from_invoke<detail::ResultKind::Err>, std::forward<F>(f),
+                                   std::move(result_storage_).err());
         }
         else
         {
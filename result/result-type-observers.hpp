@@ -5,15 +5,49 @@
 #include <functional>
 #include <type_traits>
 
+namespace result_type::detail
+{
+    // policy dependent, see `panic` in panic.hpp
+    inline namespace RESULT_PANIC_NS
+    {
+        // Failure paths of `unwrap` / `unwrap_err`, kept out of line and cold so
+        // an inlined `unwrap()` only costs a tag test and a never-taken call. One
+        // instance per `(T, E)` serves every ref-qualified overload.
+        template <typename T, typename E> struct unwrap_failed
+        {
+            [[noreturn, gnu::cold, gnu::noinline]] static void unwrap(const E &err)
+            {
+                panic("called `Result::unwrap()` on an `Err` value ", err);
+            }
+            [[noreturn, gnu::cold, gnu::noinline]] static void unwrap_err(const T &ok)
+            {
+                panic("called `Result::unwrap_err()` on an `Ok` value ", ok);
+            }
+        };
+
+        template <typename E> struct unwrap_failed<void, E>
+        {
+            [[noreturn, gnu::cold, gnu::noinline]] static void unwrap(const E &err)
+            {
+                panic("called `Result::unwrap()` on an `Err` value ", err);
+            }
+            [[noreturn, gnu::cold, gnu::noinline]] static void unwrap_err()
+            {
+                panic("called `Result::unwrap_err()` on an void `Ok` value");
+            }
+        };
+    } // namespace RESULT_PANIC_NS
+} // namespace result_type::detail
+
 namespace result_type
 {
     template <typename T, typename E> constexpr bool Result<T, E>::is_ok() const noexcept
     {
-        return result_variant_.index() == detail::ResultKind::Ok;
+        return result_storage_.kind() == detail::ResultKind::Ok;
     }
     template <typename T, typename E> constexpr bool Result<T, E>::is_err() const noexcept
     {
-        return result_variant_.index() == detail::ResultKind::Err;
+        return result_storage_.kind() != detail::ResultKind::Ok;
     }
 
     template <typename T, typename E> template <typename F> constexpr bool Result<T, E>::is_ok_and(F &&f) const &
@@ -23,7 +57,7 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.ok());
         }
         return false;
     }
@@ -34,7 +68,7 @@ namespace result_type
 
         if (is_ok())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).ok());
         }
         return false;
     }
@@ -46,7 +80,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         return false;
     }
@@ -57,7 +91,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         return false;
     }
@@ -73,11 +107,11 @@ namespace result_type
         static_assert(std::is_convertible_v<ErrRes, OkRes>);
         if (is_ok())
         {
-            return std::invoke(std::forward<OkFn>(ok_fn), std::get<detail::ResultKind::Ok>(result_variant_));
+            return std::invoke(std::forward<OkFn>(ok_fn), result_storage_.ok());
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<ErrFn>(err_fn), result_storage_.err());
         }
     }
     template <typename T, typename E>
@@ -91,11 +125,11 @@ namespace result_type
         static_assert(std::is_convertible_v<ErrRes, OkRes>);
         if (is_ok())
         {
-            return std::invoke(std::forward<OkFn>(ok_fn), std::get<detail::ResultKind::Ok>(result_variant_));
+            return std::invoke(std::forward<OkFn>(ok_fn), result_storage_.ok());
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<ErrFn>(err_fn), result_storage_.err());
         }
     }
     template <typename T, typename E>
@@ -109,12 +143,11 @@ namespace result_type
         static_assert(std::is_convertible_v<ErrRes, OkRes>);
         if (is_ok())
         {
-            return std::invoke(std::forward<OkFn>(ok_fn), std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            return std::invoke(std::forward<OkFn>(ok_fn), std::move(result_storage_).ok());
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn),
-                               std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<ErrFn>(err_fn), std::move(result_storage_).err());
         }
     }
 
@@ -123,38 +156,36 @@ namespace result_type
         static_assert(std::is_copy_assignable_v<E>, "ill-formed");
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ", std::get<detail::ResultKind::Err>(result_variant_));
+            detail::unwrap_failed<T, E>::unwrap(result_storage_.err());
         }
-        return std::get<detail::ResultKind::Ok>(result_variant_);
+        return result_storage_.ok();
     }
     template <typename T, typename E> constexpr const T &Result<T, E>::unwrap() const &
     {
         static_assert(std::is_copy_assignable_v<E>, "ill-formed");
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ", std::get<detail::ResultKind::Err>(result_variant_));
+            detail::unwrap_failed<T, E>::unwrap(result_storage_.err());
         }
-        return std::get<detail::ResultKind::Ok>(result_variant_);
+        return result_storage_.ok();
     }
     template <typename T, typename E> constexpr T &&Result<T, E>::unwrap() &&
     {
         static_assert(std::is_move_assignable_v<E>, "ill-formed");
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ",
-                  std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            detail::unwrap_failed<T, E>::unwrap(result_storage_.err());
         }
-        return std::get<detail::ResultKind::Ok>(std::move(result_variant_));
+        return std::move(result_storage_).ok();
     }
     template <typename T, typename E> constexpr const T &&Result<T, E>::unwrap() const &&
     {
         static_assert(std::is_move_assignable_v<E>, "ill-formed");
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ",
-                  std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            detail::unwrap_failed<T, E>::unwrap(result_storage_.err());
         }
-        return std::get<detail::ResultKind::Ok>(std::move(result_variant_));
+        return std::move(result_storage_).ok();
     }
 
     template <typename T, typename E> constexpr E &Result<T, E>::unwrap_err() &
@@ -162,38 +193,36 @@ namespace result_type
         static_assert(std::is_copy_assignable_v<T>, "ill-formed");
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an `Ok` value ", std::get<detail::ResultKind::Ok>(result_variant_));
+            detail::unwrap_failed<T, E>::unwrap_err(result_storage_.ok());
         }
-        return std::get<detail::ResultKind::Err>(result_variant_);
+        return result_storage_.err();
     }
     template <typename T, typename E> constexpr const E &Result<T, E>::unwrap_err() const &
     {
         static_assert(std::is_copy_assignable_v<T>, "ill-formed");
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an `Ok` value ", std::get<detail::ResultKind::Ok>(result_variant_));
+            detail::unwrap_failed<T, E>::unwrap_err(result_storage_.ok());
         }
-        return std::get<detail::ResultKind::Err>(result_variant_);
+        return result_storage_.err();
     }
     template <typename T, typename E> constexpr E &&Result<T, E>::unwrap_err() &&
     {
         static_assert(std::is_move_assignable_v<T>, "ill-formed");
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an `Ok` value ",
-                  std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            detail::unwrap_failed<T, E>::unwrap_err(result_storage_.ok());
         }
-        return std::get<detail::ResultKind::Err>(std::move(result_variant_));
+        return std::move(result_storage_).err();
     }
     template <typename T, typename E> constexpr const E &&Result<T, E>::unwrap_err() const &&
     {
         static_assert(std::is_move_assignable_v<T>, "ill-formed");
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an `Ok` value ",
-                  std::get<detail::ResultKind::Ok>(std::move(result_variant_)));
+            detail::unwrap_failed<T, E>::unwrap_err(result_storage_.ok());
         }
-        return std::get<detail::ResultKind::Err>(std::move(result_variant_));
+        return std::move(result_storage_).err();
     }
 
     template <typename T, typename E> template <class U> constexpr T Result<T, E>::unwrap_or(U &&default_value) const &
@@ -201,7 +230,7 @@ namespace result_type
         static_assert(std::is_copy_constructible_v<T>);
         static_assert(std::is_convertible_v<U, T>);
 
-        return is_ok() ? std::get<detail::ResultKind::Ok>(result_variant_)
+        return is_ok() ? result_storage_.ok()
                        : static_cast<T>(std::forward<U>(default_value));
     }
     template <typename T, typename E> template <class U> constexpr T Result<T, E>::unwrap_or(U &&default_value) &&
@@ -209,7 +238,7 @@ namespace result_type
         static_assert(std::is_move_constructible_v<T>);
         static_assert(std::is_convertible_v<U, T>);
 
-        return is_ok() ? std::get<detail::ResultKind::Ok>(std::move(result_variant_))
+        return is_ok() ? std::move(result_storage_).ok()
                        : static_cast<T>(std::forward<U>(default_value));
     }
 
@@ -220,7 +249,7 @@ namespace result_type
         static_assert(std::is_copy_constructible_v<E>);
         static_assert(std::is_convertible_v<G, E>);
 
-        return is_err() ? std::get<detail::ResultKind::Err>(result_variant_)
+        return is_err() ? result_storage_.err()
                         : static_cast<E>(std::forward<G>(default_value));
     }
     template <typename T, typename E> template <class G> constexpr E Result<T, E>::unwrap_err_or(G &&default_value) &&
@@ -228,7 +257,7 @@ namespace result_type
         static_assert(std::is_move_constructible_v<E>);
         static_assert(std::is_convertible_v<G, E>);
 
-        return is_err() ? std::get<detail::ResultKind::Err>(std::move(result_variant_))
+        return is_err() ? std::move(result_storage_).err()
                         : static_cast<E>(std::forward<G>(default_value));
     }
 
@@ -238,11 +267,11 @@ namespace result_type
 
     template <typename E> constexpr bool Result<void, E>::is_ok() const noexcept
     {
-        return result_variant_.index() == detail::ResultKind::Ok;
+        return result_storage_.kind() == detail::ResultKind::Ok;
     }
     template <typename E> constexpr bool Result<void, E>::is_err() const noexcept
     {
-        return result_variant_.index() == detail::ResultKind::Err;
+        return result_storage_.kind() != detail::ResultKind::Ok;
     }
 
     template <typename E> template <typename F> constexpr bool Result<void, E>::is_ok_and(F &&f)
@@ -264,7 +293,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<F>(f), result_storage_.err());
         }
         return false;
     }
@@ -275,7 +304,7 @@ namespace result_type
 
         if (is_err())
         {
-            return std::invoke(std::forward<F>(f), std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<F>(f), std::move(result_storage_).err());
         }
         return false;
     }
@@ -295,7 +324,7 @@ namespace result_type
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<ErrFn>(err_fn), result_storage_.err());
         }
     }
     template <typename E>
@@ -313,7 +342,7 @@ namespace result_type
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn), std::get<detail::ResultKind::Err>(result_variant_));
+            return std::invoke(std::forward<ErrFn>(err_fn), result_storage_.err());
         }
     }
     template <typename E>
@@ -331,8 +360,7 @@ namespace result_type
         }
         else
         {
-            return std::invoke(std::forward<ErrFn>(err_fn),
-                               std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            return std::invoke(std::forward<ErrFn>(err_fn), std::move(result_storage_).err());
         }
     }
 
@@ -342,7 +370,7 @@ namespace result_type
 
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ", std::get<detail::ResultKind::Err>(result_variant_));
+            detail::unwrap_failed<void, E>::unwrap(result_storage_.err());
         }
     }
     template <typename E> constexpr void Result<void, E>::unwrap() &&
@@ -352,8 +380,7 @@ namespace result_type
 
         if (is_err())
         {
-            panic("called `Result::unwrap()` on an `Err` value ",
-                  std::get<detail::ResultKind::Err>(std::move(result_variant_)));
+            detail::unwrap_failed<void, E>::unwrap(result_storage_.err());
         }
     }
 
@@ -361,33 +388,33 @@ namespace result_type
     {
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an void `Ok` value");
+            detail::unwrap_failed<void, E>::unwrap_err();
         }
-        return std::get<detail::ResultKind::Err>(result_variant_);
+        return result_storage_.err();
     }
     template <typename E> constexpr const E &Result<void, E>::unwrap_err() const &
     {
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an void `Ok` value");
+            detail::unwrap_failed<void, E>::unwrap_err();
         }
-        return std::get<detail::ResultKind::Err>(result_variant_);
+        return result_storage_.err();
     }
     template <typename E> constexpr E &&Result<void, E>::unwrap_err() &&
     {
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an void `Ok` value");
+            detail::unwrap_failed<void, E>::unwrap_err();
         }
-        return std::get<detail::ResultKind::Err>(std::move(result_variant_));
+        return std::move(result_storage_).err();
     }
     template <typename E> constexpr const E &&Result<void, E>::unwrap_err() const &&
     {
         if (is_ok())
         {
-            panic("called `Result::unwrap_err()` on an void `Ok` value");
+            detail::unwrap_failed<void, E>::unwrap_err();
         }
-        return std::get<detail::ResultKind::Err>(std::move(result_variant_));
+        return std::move(result_storage_).err();
     }
 
     template <typename E> template <class G> constexpr E Result<void, E>::unwrap_err_or(G &&default_value) const &
@@ -395,7 +422,7 @@ namespace result_type
         static_assert(std::is_copy_constructible_v<E>);
         static_assert(std::is_convertible_v<G, E>);
 
-        return is_err() ? std::get<detail::ResultKind::Err>(result_variant_)
+        return is_err() ? result_storage_.err()
                         : static_cast<E>(std::forward<G>(default_value));
     }
     template <typename E> template <class G> constexpr E Result<void, E>::unwrap_err_or(G &&default_value) &&
@@ -403,7 +430,7 @@ namespace result_type
         static_assert(std::is_move_constructible_v<E>);
         static_assert(std::is_convertible_v<G, E>);
 
-        return is_err() ? std::get<detail::ResultKind::Err>(std::move(result_variant_))
+        return is_err() ? std::move(result_storage_).err()
                         : static_cast<E>(std::forward<G>(default_value));
     }
 } // namespace result_type
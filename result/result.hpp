@@ -22,3 +22,14 @@
     })
 
 #define TRY_OK(...) TRY_OK_IMPL_(TRY_WITH_UNIQUE_SUFFIX_(TRY_OK_PLACEHOLDER, __COUNTER__), __VA_ARGS__)
+
+// Explicit instantiation of a `Result` used all over a program, e.g.
+// `Result<int, ErrCode>`. Declared with `RESULT_EXTERN_TEMPLATE(int, ErrCode);`
+// after result/result.hpp in a header every user includes, its non-template
+// members are no longer compiled in each translation unit but once, where
+// `RESULT_INSTANTIATE_TEMPLATE(int, ErrCode);` is. That instantiates every
+// non-template member, so `T` and `E` need to be copyable.
+// `result_add_instantiations()` from cmake/result-instantiations.cmake
+// generates both from a list of types.
+#define RESULT_EXTERN_TEMPLATE(...) extern template class ::result_type::Result<__VA_ARGS__>
+#define RESULT_INSTANTIATE_TEMPLATE(...) template class ::result_type::Result<__VA_ARGS__>